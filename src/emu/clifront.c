@@ -84,6 +84,93 @@ cli_options::cli_options()
 
 
 
+//**************************************************************************
+//  PARALLEL AUDITING
+//**************************************************************************
+
+// the result of auditing one set, produced on a worker and reported in order
+struct audit_result
+{
+	audit_result() : summary(media_auditor::NOTFOUND) { }
+
+	media_auditor::summary  summary;        // summary of the audit
+	astring                 text;           // detailed report, if the set was found
+};
+
+
+// a parent and its clones, audited together so that find_shared_device can
+// reuse the parent's configuration from a single enumerator
+class romset_family
+{
+	friend class simple_list<romset_family>;
+
+public:
+	romset_family(emu_options &options, const int *drivers, audit_result *results)
+		: m_next(NULL),
+			m_options(options),
+			m_drivers(drivers),
+			m_results(results) { }
+
+	romset_family *next() const { return m_next; }
+
+	romset_family *     m_next;             // next family in the list
+	emu_options &       m_options;          // options for building configs
+	const int *         m_drivers;          // driver index of each enumerated set
+	audit_result *      m_results;          // result of each enumerated set
+	dynamic_array<int>  m_members;          // positions of this family's sets
+};
+
+
+// one software list entry to audit on a worker
+struct software_audit
+{
+	media_auditor *     auditor;            // auditor owned by this entry
+	const char *        listname;           // name of the list
+	software_info *     swinfo;             // the software to audit
+	audit_result        result;             // the result
+};
+
+
+//-------------------------------------------------
+//  audit_family_callback - audit every set in a
+//  family on a worker thread
+//-------------------------------------------------
+
+static void *audit_family_callback(void *param, int threadid)
+{
+	romset_family &family = *(romset_family *)param;
+	driver_enumerator drivlist(family.m_options);
+	media_auditor auditor(drivlist);
+
+	for (int member = 0; member < family.m_members.count(); member++)
+	{
+		int position = family.m_members[member];
+		audit_result &result = family.m_results[position];
+		drivlist.set_current(family.m_drivers[position]);
+		result.summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+		if (result.summary != media_auditor::NOTFOUND)
+			auditor.summarize(drivlist.driver().name, &result.text);
+	}
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  audit_software_callback - audit one software
+//  list entry on a worker thread
+//-------------------------------------------------
+
+static void *audit_software_callback(void *param, int threadid)
+{
+	software_audit &audit = *(software_audit *)param;
+	audit.result.summary = audit.auditor->audit_software(audit.listname, audit.swinfo, AUDIT_VALIDATE_FAST);
+	if (audit.result.summary != media_auditor::NOTFOUND && audit.result.summary != media_auditor::NONE_NEEDED)
+		audit.auditor->summarize(audit.swinfo->shortname(), &audit.result.text);
+	return NULL;
+}
+
+
+
 //**************************************************************************
 //  CLI FRONTEND
 //**************************************************************************
@@ -128,6 +215,7 @@ int cli_frontend::execute(int argc, char **argv)
 {
 	// wrap the core execution in a try/catch to field all fatal errors
 	m_result = MAMERR_NONE;
+	hash_cache *hashcache = NULL;
 	try
 	{
 		// first parse options to be able to get software from it
@@ -213,6 +301,13 @@ int cli_frontend::execute(int argc, char **argv)
 		if (option_errors)
 			osd_printf_error("Error in command line:\n%s\n", option_errors.trimspace().cstr());
 
+		// remember ROM hashes between runs unless full verification was requested
+		if (m_options.hash_cache())
+		{
+			hashcache = global_alloc(hash_cache(m_options.cfg_directory(), "romhash.cache"));
+			emu_file::set_hash_cache(hashcache);
+		}
+
 		// determine the base name of the EXE
 		astring exename;
 		core_filename_extract_base(exename, argv[0], true);
@@ -291,6 +386,10 @@ int cli_frontend::execute(int argc, char **argv)
 		m_result = MAMERR_FATALERROR;
 	}
 
+	// write out any newly computed hashes
+	emu_file::set_hash_cache(NULL);
+	global_free(hashcache);
+
 	_7z_file_cache_clear();
 
 	return m_result;
@@ -811,16 +910,47 @@ void cli_frontend::verifyroms(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
-	media_auditor auditor(drivlist);
+	// gather the drivers, grouping clones with their parents
+	dynamic_array<int> drivers;
+	dynamic_array<romset_family *> family_of_root(driver_list::total(), 0);
+	simple_list<romset_family> families;
 	while (drivlist.next())
+		drivers.append(drivlist.current());
+	dynamic_array<audit_result> results(drivers.count());
+	for (int position = 0; position < drivers.count(); position++)
 	{
-		matched++;
+		int root = drivlist.non_bios_clone(drivers[position]);
+		if (root == -1)
+			root = drivers[position];
+		if (family_of_root[root] == NULL)
+			family_of_root[root] = &families.append(*global_alloc(romset_family(m_options, drivers, results)));
+		family_of_root[root]->m_members.append(position);
+	}
+
+	// audit the families in parallel
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	for (romset_family *family = families.first(); family != NULL; family = family->next())
+		if (queue != NULL)
+			osd_work_item_queue(queue, audit_family_callback, family, WORK_ITEM_FLAG_AUTO_RELEASE);
+		else
+			audit_family_callback(family, 0);
+	if (queue != NULL)
+	{
+		// a full audit can take many minutes, so wait as long as it takes
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10))
+			;
+		osd_work_queue_free(queue);
+	}
 
-		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+	// report the results in enumeration order
+	media_auditor auditor(drivlist);
+	for (int position = 0; position < drivers.count(); position++)
+	{
+		drivlist.set_current(drivers[position]);
+		matched++;
 
 		// if not found, count that and leave it at that
+		media_auditor::summary summary = results[position].summary;
 		if (summary == media_auditor::NOTFOUND)
 			notfound++;
 
@@ -828,9 +958,7 @@ void cli_frontend::verifyroms(const char *gamename)
 		else
 		{
 			// output the summary of the audit
-			astring summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
-			osd_printf_info("%s", summary_string.cstr());
+			osd_printf_info("%s", results[position].text.cstr());
 
 			// output the name of the driver and its clone
 			osd_printf_info("romset %s ", drivlist.driver().name);
@@ -1322,6 +1450,87 @@ void cli_frontend::listsoftware(const char *gamename)
 }
 
 
+/*-------------------------------------------------
+    verify_software_list - audit every entry of a
+    software list in parallel, then report the
+    results in list order
+-------------------------------------------------*/
+void cli_frontend::verify_software_list(driver_enumerator &drivlist, software_list_device &swlistdev, int &correct, int &incorrect, int &notfound)
+{
+	// build one audit per entry, each with its own auditor
+	int count = 0;
+	for (software_info *swinfo = swlistdev.first_software_info(); swinfo != NULL; swinfo = swinfo->next())
+		count++;
+	dynamic_array<software_audit> audits(count);
+	count = 0;
+	for (software_info *swinfo = swlistdev.first_software_info(); swinfo != NULL; swinfo = swinfo->next(), count++)
+	{
+		audits[count].auditor = global_alloc(media_auditor(drivlist));
+		audits[count].listname = swlistdev.list_name();
+		audits[count].swinfo = swinfo;
+	}
+
+	// audit them in parallel
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (queue != NULL && count > 0)
+	{
+		osd_work_item_queue_multiple(queue, audit_software_callback, count, &audits[0], sizeof(audits[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10))
+			;
+	}
+	else
+		for (int index = 0; index < count; index++)
+			audit_software_callback(&audits[index], 0);
+	if (queue != NULL)
+		osd_work_queue_free(queue);
+
+	// report in list order
+	for (int index = 0; index < count; index++)
+	{
+		software_audit &audit = audits[index];
+		media_auditor::summary summary = audit.result.summary;
+		global_free(audit.auditor);
+
+		// if not found, count that and leave it at that
+		if (summary == media_auditor::NOTFOUND)
+		{
+			notfound++;
+		}
+		// else display information about what we discovered
+		else if (summary != media_auditor::NONE_NEEDED)
+		{
+			// output the summary of the audit
+			osd_printf_info("%s", audit.result.text.cstr());
+
+			// display information about what we discovered
+			osd_printf_info("romset %s:%s ", swlistdev.list_name(), audit.swinfo->shortname());
+
+			// switch off of the result
+			switch (summary)
+			{
+				case media_auditor::INCORRECT:
+					osd_printf_info("is bad\n");
+					incorrect++;
+					break;
+
+				case media_auditor::CORRECT:
+					osd_printf_info("is good\n");
+					correct++;
+					break;
+
+				case media_auditor::BEST_AVAILABLE:
+					osd_printf_info("is best available\n");
+					correct++;
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+}
+
+
 /*-------------------------------------------------
     verifysoftware - verify roms from the software
     list of the specified driver(s)
@@ -1343,7 +1552,6 @@ void cli_frontend::verifysoftware(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 	}
 
-	media_auditor auditor(drivlist);
 	while (drivlist.next())
 	{
 		matched++;
@@ -1355,49 +1563,7 @@ void cli_frontend::verifysoftware(const char *gamename)
 					if (swlistdev->first_software_info() != NULL)
 					{
 						nrlists++;
-						for (software_info *swinfo = swlistdev->first_software_info(); swinfo != NULL; swinfo = swinfo->next())
-						{
-							media_auditor::summary summary = auditor.audit_software(swlistdev->list_name(), swinfo, AUDIT_VALIDATE_FAST);
-
-							// if not found, count that and leave it at that
-							if (summary == media_auditor::NOTFOUND)
-							{
-								notfound++;
-							}
-							// else display information about what we discovered
-							else if(summary != media_auditor::NONE_NEEDED)
-							{
-								// output the summary of the audit
-								astring summary_string;
-								auditor.summarize(swinfo->shortname(), &summary_string);
-								osd_printf_info("%s", summary_string.cstr());
-
-								// display information about what we discovered
-								osd_printf_info("romset %s:%s ", swlistdev->list_name(), swinfo->shortname());
-
-								// switch off of the result
-								switch (summary)
-								{
-									case media_auditor::INCORRECT:
-										osd_printf_info("is bad\n");
-										incorrect++;
-										break;
-
-									case media_auditor::CORRECT:
-										osd_printf_info("is good\n");
-										correct++;
-										break;
-
-									case media_auditor::BEST_AVAILABLE:
-										osd_printf_info("is best available\n");
-										correct++;
-										break;
-
-									default:
-										break;
-								}
-							}
-						}
+						verify_software_list(drivlist, *swlistdev, correct, incorrect, notfound);
 					}
 	}
 
@@ -1465,7 +1631,6 @@ void cli_frontend::verifysoftlist(const char *gamename)
 	int matched = 0;
 
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
 
 	while (drivlist.next())
 	{
@@ -1477,49 +1642,7 @@ void cli_frontend::verifysoftlist(const char *gamename)
 					matched++;
 
 					// Get the actual software list contents
-					for (software_info *swinfo = swlistdev->first_software_info(); swinfo != NULL; swinfo = swinfo->next())
-					{
-						media_auditor::summary summary = auditor.audit_software(swlistdev->list_name(), swinfo, AUDIT_VALIDATE_FAST);
-
-						// if not found, count that and leave it at that
-						if (summary == media_auditor::NOTFOUND)
-						{
-							notfound++;
-						}
-						// else display information about what we discovered
-						else if (summary != media_auditor::NONE_NEEDED)
-						{
-							// output the summary of the audit
-							astring summary_string;
-							auditor.summarize(swinfo->shortname(), &summary_string);
-							osd_printf_info("%s", summary_string.cstr());
-
-							// display information about what we discovered
-							osd_printf_info("romset %s:%s ", swlistdev->list_name(), swinfo->shortname());
-
-							// switch off of the result
-							switch (summary)
-							{
-								case media_auditor::INCORRECT:
-									osd_printf_info("is bad\n");
-									incorrect++;
-									break;
-
-								case media_auditor::CORRECT:
-									osd_printf_info("is good\n");
-									correct++;
-									break;
-
-								case media_auditor::BEST_AVAILABLE:
-									osd_printf_info("is best available\n");
-									correct++;
-									break;
-
-								default:
-									break;
-							}
-						}
-					}
+					verify_software_list(drivlist, *swlistdev, correct, incorrect, notfound);
 				}
 	}
 
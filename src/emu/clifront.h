@@ -111,6 +111,7 @@ private:
 	void display_help();
 	void display_suggestions(const char *gamename);
 	void output_single_softlist(FILE *out, software_list_device &swlist);
+	void verify_software_list(driver_enumerator &drivlist, software_list_device &swlistdev, int &correct, int &incorrect, int &notfound);
 
 	// internal state
 	cli_options &       m_options;
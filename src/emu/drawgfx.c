@@ -390,7 +390,7 @@ void gfx_element::opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY);
+	DRAWGFX_CORE_SPAN(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY, SPAN_OP_REBASE_OPAQUE16);
 }
 
 void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -433,7 +433,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SPAN(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, SPAN_OP_REBASE_TRANSPEN16);
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -461,7 +461,7 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SPAN(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY, SPAN_OP_REMAP_TRANSPEN32);
 }
 
 
@@ -482,7 +482,7 @@ void gfx_element::transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SPAN(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, SPAN_OP_REBASE_TRANSPEN16);
 }
 
 void gfx_element::transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -993,7 +993,7 @@ void gfx_element::prio_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SPAN(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8, SPAN_OP_REBASE_TRANSPEN16_PRIORITY);
 }
 
 void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1023,7 +1023,7 @@ void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SPAN(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8, SPAN_OP_REMAP_TRANSPEN32_PRIORITY);
 }
 
 
@@ -1046,7 +1046,7 @@ void gfx_element::prio_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SPAN(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8, SPAN_OP_REBASE_TRANSPEN16_PRIORITY);
 }
 
 void gfx_element::prio_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
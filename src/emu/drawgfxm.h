@@ -54,6 +54,13 @@
 
 #include "profiler.h"
 
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define DRAWGFX_SSE2 1
+#include <emmintrin.h>
+#else
+#define DRAWGFX_SSE2 0
+#endif
+
 
 /* special priority type meaning "none" */
 struct NO_PRIORITY { char dummy[3]; };
@@ -368,6 +375,259 @@ do
 while (0)
 
 
+/***************************************************************************
+    SPAN OPERATIONS
+***************************************************************************/
+
+/*
+    Span operations are optional companions to the PIXEL_OPs, used by
+    DRAWGFX_CORE_SPAN on unflipped rows. Each one processes as many whole
+    blocks of 16 pixels from the start of the row as it can and returns
+    the number of pixels it handled; the PIXEL_OP finishes the rest. The
+    results must match the PIXEL_OP exactly. SPAN_OP_NONE handles nothing,
+    so DRAWGFX_CORE behaves exactly as before.
+*/
+
+#define SPAN_OP_NONE(DEST, PRIORITY, SOURCE, COUNT)                                 0
+#define SPAN_OP_REBASE_OPAQUE16(DEST, PRIORITY, SOURCE, COUNT)                      drawgfx_span_rebase_opaque16(DEST, SOURCE, COUNT, color)
+#define SPAN_OP_REBASE_TRANSPEN16(DEST, PRIORITY, SOURCE, COUNT)                    drawgfx_span_rebase_transpen16(DEST, SOURCE, COUNT, color, trans_pen)
+#define SPAN_OP_REBASE_TRANSPEN16_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)           drawgfx_span_rebase_transpen16_priority(DEST, PRIORITY, SOURCE, COUNT, color, trans_pen, pmask)
+#define SPAN_OP_REMAP_TRANSPEN32(DEST, PRIORITY, SOURCE, COUNT)                     drawgfx_span_remap_transpen32(DEST, SOURCE, COUNT, paldata, trans_pen)
+#define SPAN_OP_REMAP_TRANSPEN32_PRIORITY(DEST, PRIORITY, SOURCE, COUNT)            drawgfx_span_remap_transpen32_priority(DEST, PRIORITY, SOURCE, COUNT, paldata, trans_pen, pmask)
+
+
+/*-------------------------------------------------
+    drawgfx_span_rebase_opaque16 - add 'color' to
+    16 pens at a time
+-------------------------------------------------*/
+
+INLINE INT32 drawgfx_span_rebase_opaque16(UINT16 *dest, const UINT8 *src, INT32 count, UINT32 color)
+{
+	INT32 done = 0;
+#if DRAWGFX_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i colorv = _mm_set1_epi16(color);
+	for ( ; done + 16 <= count; done += 16)
+	{
+		__m128i pix = _mm_loadu_si128((const __m128i *)&src[done]);
+		_mm_storeu_si128((__m128i *)&dest[done], _mm_add_epi16(_mm_unpacklo_epi8(pix, zero), colorv));
+		_mm_storeu_si128((__m128i *)&dest[done + 8], _mm_add_epi16(_mm_unpackhi_epi8(pix, zero), colorv));
+	}
+#endif
+	return done;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_rebase_transpen16 - add 'color'
+    to 16 pens at a time, merging the result with
+    the destination wherever the pen is not
+    'trans_pen'
+-------------------------------------------------*/
+
+INLINE INT32 drawgfx_span_rebase_transpen16(UINT16 *dest, const UINT8 *src, INT32 count, UINT32 color, UINT32 trans_pen)
+{
+	INT32 done = 0;
+#if DRAWGFX_SSE2
+	if (trans_pen > 0xff)
+		return 0;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i colorv = _mm_set1_epi16(color);
+	const __m128i transv = _mm_set1_epi8(trans_pen);
+	for ( ; done + 16 <= count; done += 16)
+	{
+		__m128i pix = _mm_loadu_si128((const __m128i *)&src[done]);
+		__m128i trans = _mm_cmpeq_epi8(pix, transv);
+		int bits = _mm_movemask_epi8(trans);
+		if (bits == 0xffff)
+			continue;
+
+		__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(pix, zero), colorv);
+		__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(pix, zero), colorv);
+		if (bits != 0)
+		{
+			__m128i translo = _mm_unpacklo_epi8(trans, trans);
+			__m128i transhi = _mm_unpackhi_epi8(trans, trans);
+			lo = _mm_or_si128(_mm_and_si128(translo, _mm_loadu_si128((const __m128i *)&dest[done])), _mm_andnot_si128(translo, lo));
+			hi = _mm_or_si128(_mm_and_si128(transhi, _mm_loadu_si128((const __m128i *)&dest[done + 8])), _mm_andnot_si128(transhi, hi));
+		}
+		_mm_storeu_si128((__m128i *)&dest[done], lo);
+		_mm_storeu_si128((__m128i *)&dest[done + 8], hi);
+	}
+#endif
+	return done;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_sse2_priority_clear - return 0xff in
+    each byte lane whose priority value does not
+    hit 'pmask', i.e. (1 << (pri & 0x1f)) & pmask
+    is zero, and 0x00 otherwise
+-------------------------------------------------*/
+
+#if DRAWGFX_SSE2
+INLINE __m128i drawgfx_sse2_priority_clear(__m128i pri, UINT32 pmask)
+{
+	const __m128i zero = _mm_setzero_si128();
+
+	/* build 1 << (pri & 7) in each byte; the value is at most 0x08 before the
+	   final shift by 4, so the 16-bit shifts never carry into the next byte */
+	__m128i bit = _mm_set1_epi8(1);
+	__m128i shift = _mm_cmpeq_epi8(_mm_and_si128(pri, _mm_set1_epi8(1)), zero);
+	bit = _mm_or_si128(_mm_and_si128(shift, bit), _mm_andnot_si128(shift, _mm_slli_epi16(bit, 1)));
+	shift = _mm_cmpeq_epi8(_mm_and_si128(pri, _mm_set1_epi8(2)), zero);
+	bit = _mm_or_si128(_mm_and_si128(shift, bit), _mm_andnot_si128(shift, _mm_slli_epi16(bit, 2)));
+	shift = _mm_cmpeq_epi8(_mm_and_si128(pri, _mm_set1_epi8(4)), zero);
+	bit = _mm_or_si128(_mm_and_si128(shift, bit), _mm_andnot_si128(shift, _mm_slli_epi16(bit, 4)));
+
+	/* pick byte (pri >> 3) & 3 of pmask for each lane */
+	__m128i index = _mm_and_si128(pri, _mm_set1_epi8(0x18));
+	__m128i maskbyte = _mm_and_si128(_mm_cmpeq_epi8(index, zero), _mm_set1_epi8(pmask));
+	maskbyte = _mm_or_si128(maskbyte, _mm_and_si128(_mm_cmpeq_epi8(index, _mm_set1_epi8(0x08)), _mm_set1_epi8(pmask >> 8)));
+	maskbyte = _mm_or_si128(maskbyte, _mm_and_si128(_mm_cmpeq_epi8(index, _mm_set1_epi8(0x10)), _mm_set1_epi8(pmask >> 16)));
+	maskbyte = _mm_or_si128(maskbyte, _mm_and_si128(_mm_cmpeq_epi8(index, _mm_set1_epi8(0x18)), _mm_set1_epi8(pmask >> 24)));
+
+	return _mm_cmpeq_epi8(_mm_and_si128(bit, maskbyte), zero);
+}
+#endif
+
+
+/*-------------------------------------------------
+    drawgfx_span_rebase_transpen16_priority - as
+    drawgfx_span_rebase_transpen16, testing the
+    priority bitmap and setting it to 31 under
+    every opaque pen, 16 pixels at a time
+-------------------------------------------------*/
+
+INLINE INT32 drawgfx_span_rebase_transpen16_priority(UINT16 *dest, UINT8 *pri, const UINT8 *src, INT32 count, UINT32 color, UINT32 trans_pen, UINT32 pmask)
+{
+	INT32 done = 0;
+#if DRAWGFX_SSE2
+	if (trans_pen > 0xff)
+		return 0;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i colorv = _mm_set1_epi16(color);
+	const __m128i transv = _mm_set1_epi8(trans_pen);
+	const __m128i top = _mm_set1_epi8(31);
+	for ( ; done + 16 <= count; done += 16)
+	{
+		__m128i pix = _mm_loadu_si128((const __m128i *)&src[done]);
+		__m128i trans = _mm_cmpeq_epi8(pix, transv);
+		if (_mm_movemask_epi8(trans) == 0xffff)
+			continue;
+
+		/* every opaque pen claims its priority pixel, drawn or not */
+		__m128i prival = _mm_loadu_si128((const __m128i *)&pri[done]);
+		__m128i draw = _mm_andnot_si128(trans, drawgfx_sse2_priority_clear(prival, pmask));
+		_mm_storeu_si128((__m128i *)&pri[done], _mm_or_si128(_mm_and_si128(trans, prival), _mm_andnot_si128(trans, top)));
+		int bits = _mm_movemask_epi8(draw);
+		if (bits == 0)
+			continue;
+
+		__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(pix, zero), colorv);
+		__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(pix, zero), colorv);
+		if (bits != 0xffff)
+		{
+			__m128i drawlo = _mm_unpacklo_epi8(draw, draw);
+			__m128i drawhi = _mm_unpackhi_epi8(draw, draw);
+			lo = _mm_or_si128(_mm_and_si128(drawlo, lo), _mm_andnot_si128(drawlo, _mm_loadu_si128((const __m128i *)&dest[done])));
+			hi = _mm_or_si128(_mm_and_si128(drawhi, hi), _mm_andnot_si128(drawhi, _mm_loadu_si128((const __m128i *)&dest[done + 8])));
+		}
+		_mm_storeu_si128((__m128i *)&dest[done], lo);
+		_mm_storeu_si128((__m128i *)&dest[done + 8], hi);
+	}
+#endif
+	return done;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_sse2_remap_merge16 - map 16 pens
+    through 'paldata' and store them wherever
+    'draw' is 0xff, keeping the destination
+    elsewhere; SSE2 has no gather, so the lookups
+    are scalar, but the merge needs no branches
+-------------------------------------------------*/
+
+#if DRAWGFX_SSE2
+INLINE void drawgfx_sse2_remap_merge16(UINT32 *dest, const UINT8 *src, const pen_t *paldata, __m128i draw)
+{
+	__m128i drawlo = _mm_unpacklo_epi8(draw, draw);
+	__m128i drawhi = _mm_unpackhi_epi8(draw, draw);
+	__m128i drawquad[4];
+	drawquad[0] = _mm_unpacklo_epi16(drawlo, drawlo);
+	drawquad[1] = _mm_unpackhi_epi16(drawlo, drawlo);
+	drawquad[2] = _mm_unpacklo_epi16(drawhi, drawhi);
+	drawquad[3] = _mm_unpackhi_epi16(drawhi, drawhi);
+	for (int quad = 0; quad < 4; quad++, src += 4, dest += 4)
+	{
+		__m128i pens = _mm_set_epi32(paldata[src[3]], paldata[src[2]], paldata[src[1]], paldata[src[0]]);
+		__m128i old = _mm_loadu_si128((const __m128i *)dest);
+		_mm_storeu_si128((__m128i *)dest, _mm_or_si128(_mm_and_si128(drawquad[quad], pens), _mm_andnot_si128(drawquad[quad], old)));
+	}
+}
+#endif
+
+
+/*-------------------------------------------------
+    drawgfx_span_remap_transpen32 - skip fully
+    transparent blocks of 16 pens and map the
+    rest through 'paldata'
+-------------------------------------------------*/
+
+INLINE INT32 drawgfx_span_remap_transpen32(UINT32 *dest, const UINT8 *src, INT32 count, const pen_t *paldata, UINT32 trans_pen)
+{
+	INT32 done = 0;
+#if DRAWGFX_SSE2
+	if (trans_pen > 0xff)
+		return 0;
+	const __m128i transv = _mm_set1_epi8(trans_pen);
+	const __m128i ones = _mm_cmpeq_epi8(transv, transv);
+	for ( ; done + 16 <= count; done += 16)
+	{
+		__m128i trans = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&src[done]), transv);
+		if (_mm_movemask_epi8(trans) == 0xffff)
+			continue;
+		drawgfx_sse2_remap_merge16(&dest[done], &src[done], paldata, _mm_andnot_si128(trans, ones));
+	}
+#endif
+	return done;
+}
+
+
+/*-------------------------------------------------
+    drawgfx_span_remap_transpen32_priority - as
+    above, with the priority test and update also
+    done 16 pixels at a time
+-------------------------------------------------*/
+
+INLINE INT32 drawgfx_span_remap_transpen32_priority(UINT32 *dest, UINT8 *pri, const UINT8 *src, INT32 count, const pen_t *paldata, UINT32 trans_pen, UINT32 pmask)
+{
+	INT32 done = 0;
+#if DRAWGFX_SSE2
+	if (trans_pen > 0xff)
+		return 0;
+	const __m128i transv = _mm_set1_epi8(trans_pen);
+	const __m128i top = _mm_set1_epi8(31);
+	for ( ; done + 16 <= count; done += 16)
+	{
+		__m128i trans = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)&src[done]), transv);
+		if (_mm_movemask_epi8(trans) == 0xffff)
+			continue;
+
+		/* every opaque pen claims its priority pixel, drawn or not */
+		__m128i prival = _mm_loadu_si128((const __m128i *)&pri[done]);
+		__m128i draw = _mm_andnot_si128(trans, drawgfx_sse2_priority_clear(prival, pmask));
+		_mm_storeu_si128((__m128i *)&pri[done], _mm_or_si128(_mm_and_si128(trans, prival), _mm_andnot_si128(trans, top)));
+		if (_mm_movemask_epi8(draw) != 0)
+			drawgfx_sse2_remap_merge16(&dest[done], &src[done], paldata, draw);
+	}
+#endif
+	return done;
+}
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -389,6 +649,9 @@ while (0)
 
 
 #define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE)                               \
+	DRAWGFX_CORE_SPAN(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, SPAN_OP_NONE)
+
+#define DRAWGFX_CORE_SPAN(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, SPAN_OP)                 \
 do {                                                                                    \
 	g_profiler.start(PROFILER_DRAWGFX);                                                 \
 	do {                                                                                \
@@ -473,22 +736,34 @@ do {
 				PIXEL_TYPE *destptr = &dest.pixt<PIXEL_TYPE>(cury, destx);          \
 				const UINT8 *srcptr = srcdata;                                      \
 				srcdata += dy;                                                      \
-																					\
+																				\
+				/* let the span operation take whole blocks of 16 first */          \
+				INT32 spandone = SPAN_OP(destptr, priptr, srcptr, destendx + 1 - destx); \
+				UINT32 rowblocks = numblocks, rowleftovers = leftovers;             \
+				if (spandone != 0)                                                  \
+				{                                                                   \
+					srcptr += spandone;                                             \
+					destptr += spandone;                                            \
+					PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, spandone);              \
+					rowblocks = (destendx + 1 - destx - spandone) / 4;              \
+					rowleftovers = (destendx + 1 - destx - spandone) - 4 * rowblocks; \
+				}                                                                   \
+																				\
 				/* iterate over unrolled blocks of 4 */                             \
-				for (curx = 0; curx < numblocks; curx++)                            \
+				for (curx = 0; curx < rowblocks; curx++)                            \
 				{                                                                   \
 					PIXEL_OP(destptr[0], priptr[0], srcptr[0]);                     \
 					PIXEL_OP(destptr[1], priptr[1], srcptr[1]);                     \
 					PIXEL_OP(destptr[2], priptr[2], srcptr[2]);                     \
 					PIXEL_OP(destptr[3], priptr[3], srcptr[3]);                     \
-																					\
+																				\
 					srcptr += 4;                                                    \
 					destptr += 4;                                                   \
 					PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, 4);                     \
 				}                                                                   \
-																					\
+																				\
 				/* iterate over leftover pixels */                                  \
-				for (curx = 0; curx < leftovers; curx++)                            \
+				for (curx = 0; curx < rowleftovers; curx++)                         \
 				{                                                                   \
 					PIXEL_OP(destptr[0], priptr[0], srcptr[0]);                     \
 					srcptr++;                                                       \
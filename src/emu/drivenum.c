@@ -79,23 +79,25 @@ int driver_list::driver_sort_callback(const void *elem1, const void *elem2)
 
 //-------------------------------------------------
 //  penalty_compare - compare two strings for
-//  closeness and assign a score.
+//  closeness and assign a score; scores above
+//  limit are only known to be above limit
 //-------------------------------------------------
 
-int driver_list::penalty_compare(const char *source, const char *target)
+int driver_list::penalty_compare(const char *source, const char *target, int limit)
 {
 	int gaps = 1;
 	bool last = true;
+	int sourcech = tolower((UINT8)*source);
 
 	// scan the strings
-	for ( ; *source && *target; target++)
+	for ( ; sourcech != 0 && *target; target++)
 	{
 		// do a case insensitive match
-		bool match = (tolower((UINT8)*source) == tolower((UINT8)*target));
+		bool match = (sourcech == tolower((UINT8)*target));
 
 		// if we matched, advance the source
 		if (match)
-			source++;
+			sourcech = tolower((UINT8)*++source);
 
 		// if the match state changed, count gaps
 		if (match != last)
@@ -104,6 +106,10 @@ int driver_list::penalty_compare(const char *source, const char *target)
 			if (!match)
 				gaps++;
 		}
+
+		// gaps never go back down, so stop once we can't get under the limit
+		if (gaps > MAX(limit, 1))
+			return gaps;
 	}
 
 	// penalty if short string does not completely fit in
@@ -123,6 +129,19 @@ int driver_list::penalty_compare(const char *source, const char *target)
 //  DRIVER ENUMERATOR
 //**************************************************************************
 
+//-------------------------------------------------
+//  trigram_pair_compare - qsort callback for
+//  (trigram << 32 | driver index) pairs
+//-------------------------------------------------
+
+static int trigram_pair_compare(const void *item1, const void *item2)
+{
+	UINT64 pair1 = *reinterpret_cast<const UINT64 *>(item1);
+	UINT64 pair2 = *reinterpret_cast<const UINT64 *>(item2);
+	return (pair1 < pair2) ? -1 : (pair1 > pair2) ? 1 : 0;
+}
+
+
 //-------------------------------------------------
 //  driver_enumerator - constructor
 //-------------------------------------------------
@@ -132,7 +151,8 @@ driver_enumerator::driver_enumerator(emu_options &options)
 		m_filtered_count(0),
 		m_options(options),
 		m_included(s_driver_count, 0),
-		m_config(s_driver_count, 0)
+		m_config(s_driver_count, 0),
+		m_searches(0)
 {
 	include_all();
 }
@@ -143,7 +163,8 @@ driver_enumerator::driver_enumerator(emu_options &options, const char *string)
 		m_filtered_count(0),
 		m_options(options),
 		m_included(s_driver_count, 0),
-		m_config(s_driver_count, 0)
+		m_config(s_driver_count, 0),
+		m_searches(0)
 {
 	filter(string);
 }
@@ -154,7 +175,8 @@ driver_enumerator::driver_enumerator(emu_options &options, const game_driver &dr
 		m_filtered_count(0),
 		m_options(options),
 		m_included(s_driver_count, 0),
-		m_config(s_driver_count, 0)
+		m_config(s_driver_count, 0),
+		m_searches(0)
 {
 	filter(driver);
 }
@@ -349,6 +371,19 @@ void driver_enumerator::find_approximate_matches(const char *string, int count,
 		results[matchnum] = -1;
 	}
 
+	// a one-shot search goes straight to the scan; repeated searches (e.g.
+	// typing in the game selector) first rank the likeliest drivers from the
+	// trigram index, so that the scan can reject nearly everything else early
+	dynamic_array<int> ranked;
+	if (++m_searches > 1)
+		find_indexed_matches(string, count, results, penalty, ranked);
+
+	// the characters of the search string, as bits in the masks kept with the index
+	int length = strlen(string);
+	dynamic_array<UINT64> charbits(length);
+	for (int charnum = 0; charnum < length; charnum++)
+		charbits[charnum] = char_mask(string[charnum]);
+
 	// scan the entire drivers array
 	for (int index = 0; index < s_driver_count; index++)
 		if (m_included[index])
@@ -357,28 +392,238 @@ void driver_enumerator::find_approximate_matches(const char *string, int count,
 			if ((s_drivers_sorted[index]->flags & GAME_NO_STANDALONE) != 0)
 				continue;
 
-			// pick the best match between driver name and description
-			int curpenalty = penalty_compare(string, s_drivers_sorted[index]->description);
-			int tmp = penalty_compare(string, s_drivers_sorted[index]->name);
-			curpenalty = MIN(curpenalty, tmp);
+			// skip things already ranked from the index
+			if (ranked.count() != 0 && m_trigram_hits[index] != 0)
+				continue;
+
+			// skip things missing a character too early in the search string to beat the table
+			if (m_char_masks.count() != 0 && penalty_bound(charbits, m_char_masks[index * 2]) > penalty[count - 1] && penalty_bound(charbits, m_char_masks[index * 2 + 1]) > penalty[count - 1])
+				continue;
+			rank_match(string, index, count, results, penalty);
+		}
+
+	// clear the marks left by the index
+	for (int rankednum = 0; rankednum < ranked.count(); rankednum++)
+		m_trigram_hits[ranked[rankednum]] = 0;
+}
+
 
-			// insert into the sorted table of matches
-			for (int matchnum = count - 1; matchnum >= 0; matchnum--)
+//-------------------------------------------------
+//  rank_match - score a driver against the
+//  search string and insert it into the sorted
+//  table of matches
+//-------------------------------------------------
+
+void driver_enumerator::rank_match(const char *string, int index, int count, int *results, int *penalty) const
+{
+	// pick the best match between driver name and description; neither needs
+	// an exact score once it's worse than the last entry in the table
+	int curpenalty = penalty_compare(string, s_drivers_sorted[index]->description, penalty[count - 1]);
+	int tmp = penalty_compare(string, s_drivers_sorted[index]->name, MIN(curpenalty, penalty[count - 1]));
+	curpenalty = MIN(curpenalty, tmp);
+
+	// insert into the sorted table of matches
+	for (int matchnum = count - 1; matchnum >= 0; matchnum--)
+	{
+		// stop if we're worse than the current entry; ties go to the earlier
+		// driver, so the table doesn't depend on the order drivers are ranked
+		if (curpenalty > penalty[matchnum] || (curpenalty == penalty[matchnum] && index > results[matchnum]))
+			break;
+
+		// as long as this isn't the last entry, bump this one down
+		if (matchnum < count - 1)
+		{
+			penalty[matchnum + 1] = penalty[matchnum];
+			results[matchnum + 1] = results[matchnum];
+		}
+		results[matchnum] = index;
+		penalty[matchnum] = curpenalty;
+	}
+}
+
+
+//-------------------------------------------------
+//  find_indexed_matches - rank the drivers
+//  sharing the most trigrams with the search
+//  string, leaving them marked in the hit counts
+//-------------------------------------------------
+
+void driver_enumerator::find_indexed_matches(const char *string, int count, int *results, int *penalty, dynamic_array<int> &ranked)
+{
+	// strings too short to form a trigram go through the full scan
+	UINT32 trigrams[MAX_QUERY_TRIGRAMS];
+	int numtrigrams = extract_trigrams(string, trigrams, MAX_QUERY_TRIGRAMS);
+	if (numtrigrams == 0)
+		return;
+
+	// build the index on first use
+	if (m_trigram_start.count() == 0)
+		build_trigram_index();
+	if (m_trigram_hits.count() != s_driver_count)
+		m_trigram_hits.resize_and_clear(s_driver_count);
+
+	// count the trigrams each driver shares with the search string
+	dynamic_array<int> touched;
+	for (int trignum = 0; trignum < numtrigrams; trignum++)
+	{
+		// binary search for the trigram
+		int lo = 0, hi = m_trigram_keys.count();
+		while (lo < hi)
+		{
+			int mid = (lo + hi) / 2;
+			if (m_trigram_keys[mid] < trigrams[trignum])
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo == m_trigram_keys.count() || m_trigram_keys[lo] != trigrams[trignum])
+			continue;
+
+		// bump each driver in its postings
+		for (int postnum = m_trigram_start[lo]; postnum < m_trigram_start[lo + 1]; postnum++)
+		{
+			int index = m_trigram_postings[postnum];
+			if (m_trigram_hits[index]++ == 0)
+				touched.append(index);
+		}
+	}
+
+	// histogram the eligible drivers by hit count
+	int levels[MAX_QUERY_TRIGRAMS + 1] = { 0 };
+	for (int touchnum = 0; touchnum < touched.count(); touchnum++)
+	{
+		int index = touched[touchnum];
+		if (m_included[index] && (s_drivers_sorted[index]->flags & GAME_NO_STANDALONE) == 0)
+			levels[m_trigram_hits[index]]++;
+		else
+			m_trigram_hits[index] = 0;
+	}
+
+	// find the lowest hit count that still keeps the candidate set small
+	int wanted = MAX(count * TRIGRAM_CANDIDATES_PER_MATCH, 64);
+	int threshold = numtrigrams;
+	for (int total = levels[threshold]; threshold > 1 && total < wanted; )
+		total += levels[--threshold];
+
+	// rank the candidates precisely; the rest are cleared for the full scan
+	for (int touchnum = 0; touchnum < touched.count(); touchnum++)
+	{
+		int index = touched[touchnum];
+		if (m_trigram_hits[index] >= threshold)
+		{
+			rank_match(string, index, count, results, penalty);
+			ranked.append(index);
+		}
+		else
+			m_trigram_hits[index] = 0;
+	}
+}
+
+
+//-------------------------------------------------
+//  build_trigram_index - index the trigrams of
+//  every driver's name and description
+//-------------------------------------------------
+
+void driver_enumerator::build_trigram_index()
+{
+	// gather (trigram, driver) pairs
+	dynamic_array<UINT64> pairs;
+	UINT32 trigrams[256];
+	m_char_masks.resize_and_clear(s_driver_count * 2);
+	for (int index = 0; index < s_driver_count; index++)
+	{
+		for (const char *name = s_drivers_sorted[index]->name; *name != 0; name++)
+			m_char_masks[index * 2] |= char_mask(*name);
+		for (const char *description = s_drivers_sorted[index]->description; *description != 0; description++)
+			m_char_masks[index * 2 + 1] |= char_mask(*description);
+		int numtrigrams = extract_trigrams(s_drivers_sorted[index]->name, trigrams, ARRAY_LENGTH(trigrams));
+		for (int trignum = 0; trignum < numtrigrams; trignum++)
+			pairs.append((UINT64(trigrams[trignum]) << 32) | index);
+		numtrigrams = extract_trigrams(s_drivers_sorted[index]->description, trigrams, ARRAY_LENGTH(trigrams));
+		for (int trignum = 0; trignum < numtrigrams; trignum++)
+			pairs.append((UINT64(trigrams[trignum]) << 32) | index);
+	}
+
+	// sort so that postings for each trigram are adjacent, in driver order
+	if (pairs.count() > 0)
+		qsort(&pairs[0], pairs.count(), sizeof(pairs[0]), trigram_pair_compare);
+
+	// count distinct trigrams and postings, dropping duplicates between name and description
+	int numkeys = 0, numpostings = 0;
+	for (int pairnum = 0; pairnum < pairs.count(); pairnum++)
+		if (pairnum == 0 || pairs[pairnum] != pairs[pairnum - 1])
+		{
+			if (pairnum == 0 || (pairs[pairnum] >> 32) != (pairs[pairnum - 1] >> 32))
+				numkeys++;
+			numpostings++;
+		}
+
+	// fill in the tables
+	m_trigram_keys.resize(numkeys);
+	m_trigram_start.resize(numkeys + 1);
+	m_trigram_postings.resize(numpostings);
+	int keynum = -1, postnum = 0;
+	for (int pairnum = 0; pairnum < pairs.count(); pairnum++)
+		if (pairnum == 0 || pairs[pairnum] != pairs[pairnum - 1])
+		{
+			if (pairnum == 0 || (pairs[pairnum] >> 32) != (pairs[pairnum - 1] >> 32))
 			{
-				// stop if we're worse than the current entry
-				if (curpenalty >= penalty[matchnum])
-					break;
-
-				// as long as this isn't the last entry, bump this one down
-				if (matchnum < count - 1)
-				{
-					penalty[matchnum + 1] = penalty[matchnum];
-					results[matchnum + 1] = results[matchnum];
-				}
-				results[matchnum] = index;
-				penalty[matchnum] = curpenalty;
+				m_trigram_keys[++keynum] = pairs[pairnum] >> 32;
+				m_trigram_start[keynum] = postnum;
 			}
+			m_trigram_postings[postnum++] = UINT32(pairs[pairnum]);
 		}
+	m_trigram_start[numkeys] = postnum;
+}
+
+
+//-------------------------------------------------
+//  penalty_bound - lower bound on penalty_compare
+//  from the characters a string contains: the
+//  search string can't be matched past its first
+//  character missing from the string
+//-------------------------------------------------
+
+int driver_enumerator::penalty_bound(const dynamic_array<UINT64> &charbits, UINT64 mask)
+{
+	for (int charnum = 0; charnum < charbits.count(); charnum++)
+		if ((mask & charbits[charnum]) == 0)
+			return 1 + charbits.count() - charnum;
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  extract_trigrams - collect the distinct
+//  case-folded trigrams of the alphanumeric
+//  characters in a string
+//-------------------------------------------------
+
+int driver_enumerator::extract_trigrams(const char *string, UINT32 *trigrams, int maxtrigrams)
+{
+	UINT32 window = 0;
+	int chars = 0;
+	int found = 0;
+	for ( ; *string != 0 && found < maxtrigrams; string++)
+	{
+		// punctuation and spaces are ignored entirely
+		UINT8 ch = *string;
+		if (!isalnum(ch))
+			continue;
+		window = ((window << 8) | tolower(ch)) & 0xffffff;
+		if (++chars < 3)
+			continue;
+
+		// add if not already present
+		int trignum;
+		for (trignum = 0; trignum < found; trignum++)
+			if (trigrams[trignum] == window)
+				break;
+		if (trignum == found)
+			trigrams[found++] = window;
+	}
+	return found;
 }
 
 
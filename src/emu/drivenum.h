@@ -50,7 +50,7 @@ public:
 
 	// static helpers
 	static bool matches(const char *wildstring, const char *string);
-	static int penalty_compare(const char *source, const char *target);
+	static int penalty_compare(const char *source, const char *target, int limit = 9999);
 
 protected:
 	// internal helpers
@@ -118,6 +118,12 @@ public:
 private:
 	// internal helpers
 	void release_current();
+	void rank_match(const char *string, int index, int count, int *results, int *penalty) const;
+	void find_indexed_matches(const char *string, int count, int *results, int *penalty, dynamic_array<int> &ranked);
+	void build_trigram_index();
+	static int extract_trigrams(const char *string, UINT32 *trigrams, int maxtrigrams);
+	static int penalty_bound(const dynamic_array<UINT64> &charbits, UINT64 mask);
+	static UINT64 char_mask(char ch) { return U64(1) << (tolower((UINT8)ch) & 63); }
 
 	// entry in the config cache
 	struct config_entry
@@ -142,6 +148,10 @@ private:
 
 	static const int CONFIG_CACHE_COUNT = 100;
 
+	// approximate matching candidates ranked from the trigram index before the full scan, per result wanted
+	static const int TRIGRAM_CANDIDATES_PER_MATCH = 8;
+	static const int MAX_QUERY_TRIGRAMS = 64;
+
 	// internal state
 	int                 m_current;
 	int                 m_filtered_count;
@@ -149,6 +159,14 @@ private:
 	dynamic_array<UINT8> m_included;
 	mutable dynamic_array<machine_config *> m_config;
 	mutable simple_list<config_entry> m_config_cache;
+
+	// trigram index over names and descriptions, built on the second search
+	int                 m_searches;
+	dynamic_array<UINT32> m_trigram_keys;     // distinct trigrams, sorted
+	dynamic_array<int>  m_trigram_start;      // first posting per trigram, plus an end marker
+	dynamic_array<int>  m_trigram_postings;   // driver indexes containing each trigram
+	dynamic_array<UINT8> m_trigram_hits;      // per-driver scratch for a search
+	dynamic_array<UINT64> m_char_masks;       // characters present in each name and description
 };
 
 #endif
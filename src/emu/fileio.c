@@ -16,6 +16,9 @@
 
 const UINT32 OPEN_FLAG_HAS_CRC  = 0x10000;
 
+// first line of the hash cache file; bump when the key format changes
+static const char HASH_CACHE_HEADER[] = "# hash cache v1";
+
 
 
 //**************************************************************************
@@ -130,10 +133,134 @@ const osd_directory_entry *file_enumerator::next()
 
 
 
+//**************************************************************************
+//  HASH CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  hash_cache - constructor; load any existing
+//  cache file
+//-------------------------------------------------
+
+hash_cache::hash_cache(const char *searchpath, const char *filename)
+	: m_searchpath(searchpath),
+		m_filename(filename),
+		m_lock(osd_lock_alloc()),
+		m_dirty(false)
+{
+	emu_file file(m_searchpath, OPEN_FLAG_READ);
+	if (file.open(m_filename) != FILERR_NONE)
+		return;
+
+	// ignore caches written with a different format
+	char buffer[1024];
+	if (file.gets(buffer, ARRAY_LENGTH(buffer)) == NULL || strncmp(buffer, HASH_CACHE_HEADER, strlen(HASH_CACHE_HEADER)) != 0)
+		return;
+
+	// each line is the key, a tab, and the hashes in internal form
+	while (file.gets(buffer, ARRAY_LENGTH(buffer)) != NULL)
+	{
+		char *tab = strrchr(buffer, '\t');
+		if (tab == NULL)
+			continue;
+		*tab++ = 0;
+		char *end = tab + strlen(tab);
+		while (end > tab && (end[-1] == '\r' || end[-1] == '\n'))
+			*--end = 0;
+
+		hash_collection *hashes = global_alloc(hash_collection);
+		if (hashes->from_internal_string(tab) && m_map.add(buffer, hashes) == TMERR_NONE)
+			continue;
+		global_free(hashes);
+	}
+}
+
+
+//-------------------------------------------------
+//  ~hash_cache - destructor; write back any new
+//  entries
+//-------------------------------------------------
+
+hash_cache::~hash_cache()
+{
+	save();
+	for (tagmap_t<hash_collection *, 4093>::entry_t *entry = m_map.first(); entry != NULL; entry = m_map.next(entry))
+		global_free(entry->object());
+	m_map.reset();
+	osd_lock_free(m_lock);
+}
+
+
+//-------------------------------------------------
+//  find - look up the hashes stored for a key
+//-------------------------------------------------
+
+bool hash_cache::find(const char *key, hash_collection &hashes)
+{
+	osd_lock_acquire(m_lock);
+	hash_collection *found = m_map.find(key);
+	if (found != NULL)
+		hashes = *found;
+	osd_lock_release(m_lock);
+	return (found != NULL);
+}
+
+
+//-------------------------------------------------
+//  add - store the hashes for a key, replacing
+//  any previous entry
+//-------------------------------------------------
+
+void hash_cache::add(const char *key, const hash_collection &hashes)
+{
+	osd_lock_acquire(m_lock);
+	hash_collection *existing = m_map.find(key);
+	if (existing == NULL)
+		m_map.add(key, global_alloc(hash_collection(hashes)));
+	else if (*existing != hashes)
+		*existing = hashes;
+	else
+	{
+		osd_lock_release(m_lock);
+		return;
+	}
+	m_dirty = true;
+	osd_lock_release(m_lock);
+}
+
+
+//-------------------------------------------------
+//  save - write the cache file if anything has
+//  been added since it was loaded
+//-------------------------------------------------
+
+void hash_cache::save()
+{
+	osd_lock_acquire(m_lock);
+	if (m_dirty)
+	{
+		emu_file file(m_searchpath, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		if (file.open(m_filename) == FILERR_NONE)
+		{
+			astring tempstr;
+			file.printf("%s\n", HASH_CACHE_HEADER);
+			for (tagmap_t<hash_collection *, 4093>::entry_t *entry = m_map.first(); entry != NULL; entry = m_map.next(entry))
+				file.printf("%s\t%s\n", entry->tag().cstr(), entry->object()->internal_string(tempstr));
+			m_dirty = false;
+		}
+	}
+	osd_lock_release(m_lock);
+}
+
+
+
 //**************************************************************************
 //  EMU FILE
 //**************************************************************************
 
+hash_cache *emu_file::s_hash_cache = NULL;
+
+
 //-------------------------------------------------
 //  emu_file - constructor
 //-------------------------------------------------
@@ -214,6 +341,9 @@ emu_file::operator core_file &()
 
 hash_collection &emu_file::hashes(const char *types)
 {
+	// pick up anything the persistent cache knows about this file
+	cached_hashes(types);
+
 	// determine the hashes we already have
 	astring already_have;
 	m_hashes.hash_types(already_have);
@@ -236,28 +366,70 @@ hash_collection &emu_file::hashes(const char *types)
 
 	// if we have ZIP data, just hash that directly
 	if (m__7zdata.count() != 0)
-	{
 		m_hashes.compute(m__7zdata, m__7zdata.count(), needed);
-		return m_hashes;
+	else if (m_zipdata.count() != 0)
+		m_hashes.compute(m_zipdata, m_zipdata.count(), needed);
+	else
+	{
+		// read the data if we can
+		const UINT8 *filedata = (const UINT8 *)core_fbuffer(m_file);
+		if (filedata == NULL)
+			return m_hashes;
+
+		// compute the hash
+		m_hashes.compute(filedata, core_fsize(m_file), needed);
 	}
 
-	if (m_zipdata.count() != 0)
-	{
-		m_hashes.compute(m_zipdata, m_zipdata.count(), needed);
+	// remember them for next time
+	cache_hashes(m_hashes);
+	return m_hashes;
+}
+
+
+//-------------------------------------------------
+//  cached_hashes - returns the hashes for a file
+//  after merging in the persistent cache, without
+//  reading any file data
+//-------------------------------------------------
+
+hash_collection &emu_file::cached_hashes(const char *types)
+{
+	// only archive members have a key we can trust
+	if (s_hash_cache == NULL || !m_hashkey)
 		return m_hashes;
-	}
 
-	// read the data if we can
-	const UINT8 *filedata = (const UINT8 *)core_fbuffer(m_file);
-	if (filedata == NULL)
+	// nothing to do if we already have everything
+	astring already_have;
+	m_hashes.hash_types(already_have);
+	const char *scan;
+	for (scan = types; *scan != 0; scan++)
+		if (already_have.chr(0, *scan) == -1)
+			break;
+	if (*scan == 0)
 		return m_hashes;
 
-	// compute the hash
-	m_hashes.compute(filedata, core_fsize(m_file), needed);
+	hash_collection cached;
+	if (s_hash_cache->find(m_hashkey, cached))
+		m_hashes = cached;
 	return m_hashes;
 }
 
 
+//-------------------------------------------------
+//  cache_hashes - record hashes computed for this
+//  file elsewhere, and add them to the persistent
+//  cache
+//-------------------------------------------------
+
+void emu_file::cache_hashes(const hash_collection &hashes)
+{
+	if (&hashes != &m_hashes)
+		m_hashes = hashes;
+	if (s_hash_cache != NULL && m_hashkey)
+		s_hash_cache->add(m_hashkey, m_hashes);
+}
+
+
 //-------------------------------------------------
 //  open - open a file by searching paths
 //-------------------------------------------------
@@ -416,6 +588,7 @@ void emu_file::close()
 
 	// reset our hashes and path as well
 	m_hashes.reset();
+	m_hashkey.reset();
 	m_fullpath.reset();
 }
 
@@ -524,6 +697,60 @@ UINT64 emu_file::size()
 }
 
 
+//-------------------------------------------------
+//  map - map the whole file copy-on-write instead
+//  of reading it, when it is a loose file or a
+//  stored ZIP member; the caller owns the mapping
+//  and releases it with osd_unmap
+//-------------------------------------------------
+
+file_error emu_file::map(void **base)
+{
+	// 7z data is always compressed
+	if (m__7zfile != NULL)
+		return FILERR_FAILURE;
+
+	// stored ZIP members map straight out of the archive, as long as they haven't been loaded
+	if (m_zipfile != NULL)
+		return (zip_file_map(m_zipfile, base) == ZIPERR_NONE) ? FILERR_NONE : FILERR_FAILURE;
+
+	// otherwise, let the core file decide
+	if (m_file == NULL)
+		return FILERR_FAILURE;
+	return core_fmap(m_file, base);
+}
+
+
+//-------------------------------------------------
+//  preload_zipped - unpack a ZIP member opened
+//  with OPEN_FLAG_NO_PRELOAD now, so the first
+//  read doesn't have to; may run on a worker
+//  thread as long as nothing else touches the
+//  file meanwhile
+//-------------------------------------------------
+
+void emu_file::preload_zipped()
+{
+	if (m_zipfile != NULL)
+		load_zipped_file();
+}
+
+
+//-------------------------------------------------
+//  preload_7zped - unpack a 7z member opened
+//  with OPEN_FLAG_NO_PRELOAD now; members of one
+//  solid block only share its decoded copy when
+//  each is unpacked, and the archive closed back
+//  into the cache, before the next is opened
+//-------------------------------------------------
+
+void emu_file::preload_7zped()
+{
+	if (m__7zfile != NULL)
+		load__7zped_file();
+}
+
+
 //-------------------------------------------------
 //  read - read from a file
 //-------------------------------------------------
@@ -714,6 +941,10 @@ file_error emu_file::attempt_zipped()
 			// build a hash with just the CRC
 			m_hashes.reset();
 			m_hashes.add_crc(header->crc);
+
+			// key the hash cache on the archive and the member's size, CRC and timestamp
+			m_hashkey.printf("%s.zip|%u|%s|%u|%08x|%04x%04x", m_fullpath.cstr(), UINT32(zip->length), header->filename,
+					header->uncompressed_length, header->crc, header->file_date, header->file_time);
 			return (m_openflags & OPEN_FLAG_NO_PRELOAD) ? FILERR_NONE : load_zipped_file();
 		}
 
@@ -839,6 +1070,9 @@ file_error emu_file::attempt__7zped()
 			// build a hash with just the CRC
 			m_hashes.reset();
 			m_hashes.add_crc(_7z->crc);
+
+			// 7z members carry no timestamp we can see, so key on position, size and CRC
+			m_hashkey.printf("%s.7z|%d|%u|%08x", m_fullpath.cstr(), fileno, UINT32(_7z->uncompressed_length), UINT32(_7z->crc));
 			return (m_openflags & OPEN_FLAG_NO_PRELOAD) ? FILERR_NONE : load__7zped_file();
 		}
 
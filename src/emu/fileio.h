@@ -79,6 +79,35 @@ private:
 
 
 
+// ======================> hash_cache
+
+// persistent cache of hashes computed for files inside archives, so that
+// unchanged archives do not need to be inflated and rehashed on every run
+class hash_cache
+{
+public:
+	// construction/destruction
+	hash_cache(const char *searchpath, const char *filename);
+	~hash_cache();
+
+	// lookup/update
+	bool find(const char *key, hash_collection &hashes);
+	void add(const char *key, const hash_collection &hashes);
+
+	// write any new entries back to disk
+	void save();
+
+private:
+	// internal state
+	astring         m_searchpath;                   // where the cache lives
+	astring         m_filename;                     // name of the cache file
+	osd_lock *      m_lock;                         // lock for concurrent hashing
+	bool            m_dirty;                        // true if we have entries to write
+	tagmap_t<hash_collection *, 4093> m_map;        // map from key to hashes
+};
+
+
+
 // ======================> emu_file
 
 class emu_file
@@ -89,6 +118,9 @@ public:
 	emu_file(const char *searchpath, UINT32 openflags);
 	virtual ~emu_file();
 
+	// persistent hash cache, shared by all files
+	static void set_hash_cache(hash_cache *cache) { s_hash_cache = cache; }
+
 	// getters
 	operator core_file *();
 	operator core_file &();
@@ -97,6 +129,8 @@ public:
 	const char *fullpath() const { return m_fullpath; }
 	UINT32 openflags() const { return m_openflags; }
 	hash_collection &hashes(const char *types);
+	hash_collection &cached_hashes(const char *types);
+	void cache_hashes(const hash_collection &hashes);
 
 	// setters
 	void remove_on_close() { m_remove_on_close = true; }
@@ -124,6 +158,9 @@ public:
 
 	// reading
 	UINT32 read(void *buffer, UINT32 length);
+	file_error map(void **base);
+	void preload_zipped();
+	void preload_7zped();
 	int getc();
 	int ungetc(int c);
 	char *gets(char *s, int n);
@@ -164,6 +201,9 @@ private:
 	UINT64          m__7zlength;                    // 7Z file length
 
 	bool            m_remove_on_close;              // flag: remove the file when closing
+	astring         m_hashkey;                      // key into the hash cache, if cacheable
+
+	static hash_cache *s_hash_cache;                // persistent hash cache, if enabled
 };
 
 
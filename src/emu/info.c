@@ -174,8 +174,7 @@ const char info_xml_creator::s_dtd_string[] =
 //-------------------------------------------------
 
 info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
-	: m_output(NULL),
-		m_drivlist(drivlist),
+	: m_drivlist(drivlist),
 		m_lookup_options(m_drivlist.options())
 {
 	m_lookup_options.remove_device_options();
@@ -189,18 +188,16 @@ info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
 
 void info_xml_creator::output(FILE *out)
 {
-	m_output = out;
-
 	// output the DTD
-	fprintf(m_output, "<?xml version=\"1.0\"?>\n");
+	fprintf(out, "<?xml version=\"1.0\"?>\n");
 	astring dtd(s_dtd_string);
 	dtd.replace(0,"__XML_ROOT__", emulator_info::get_xml_root());
 	dtd.replace(0,"__XML_TOP__", emulator_info::get_xml_top());
 
-	fprintf(m_output, "%s\n\n", dtd.cstr());
+	fprintf(out, "%s\n\n", dtd.cstr());
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	fprintf(out, "<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 		"yes"
 #else
@@ -208,19 +205,112 @@ void info_xml_creator::output(FILE *out)
 #endif
 		"\" mameconfig=\"%d\">\n",
 		emulator_info::get_xml_root(),
-		xml_normalize_string(build_version),
+		normalize_string(build_version),
 		CONFIG_VERSION
 	);
 
-	// iterate through the drivers, outputting one at a time
+	// gather the drivers to output
+	dynamic_array<int> drivers;
 	while (m_drivlist.next())
-		output_one();
+		drivers.append(m_drivlist.current());
+
+	// format batches of drivers on worker threads, writing each batch out in
+	// driver order as soon as it is done; only BATCHES_IN_FLIGHT batches exist
+	// at once, so memory stays flat however many drivers there are
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	driver_batch batches[BATCHES_IN_FLIGHT];
+	int batchcount = (drivers.count() + BATCH_DRIVERS - 1) / BATCH_DRIVERS;
+	int queued = 0;
+	for (int written = 0; written < batchcount; written++)
+	{
+		// keep the window full
+		for ( ; queued < batchcount && queued < written + BATCHES_IN_FLIGHT; queued++)
+		{
+			driver_batch &batch = batches[queued % BATCHES_IN_FLIGHT];
+			batch.options = &m_drivlist.options();
+			batch.drivers = &drivers[queued * BATCH_DRIVERS];
+			batch.count = MIN(BATCH_DRIVERS, drivers.count() - queued * BATCH_DRIVERS);
+			batch.item = (queue != NULL) ? osd_work_item_queue(queue, output_batch, &batch, 0) : NULL;
+			if (batch.item == NULL)
+				output_batch(&batch, 0);
+		}
+
+		// write out the oldest batch
+		driver_batch &batch = batches[written % BATCHES_IN_FLIGHT];
+		if (batch.item != NULL)
+		{
+			while (!osd_work_item_wait(batch.item, osd_ticks_per_second() * 10))
+				;
+			osd_work_item_release(batch.item);
+			batch.item = NULL;
+		}
+		fputs(batch.output, out);
+		batch.output.reset();
+	}
+	if (queue != NULL)
+		osd_work_queue_free(queue);
 
 	// output devices (both devices with roms and slot devices)
+	m_output.reset();
 	output_devices();
+	fputs(m_output, out);
 
 	// close the top level tag
-	fprintf(m_output, "</%s>\n",emulator_info::get_xml_root());
+	fprintf(out, "</%s>\n",emulator_info::get_xml_root());
+}
+
+
+//-------------------------------------------------
+//  output_batch - format a batch of drivers on a
+//  worker, with its own enumerator so that each
+//  batch builds and frees its own configs
+//-------------------------------------------------
+
+void *info_xml_creator::output_batch(void *param, int threadid)
+{
+	driver_batch &batch = *(driver_batch *)param;
+	driver_enumerator drivlist(*batch.options);
+	info_xml_creator creator(drivlist);
+	for (int index = 0; index < batch.count; index++)
+	{
+		drivlist.set_current(batch.drivers[index]);
+		creator.output_one();
+	}
+	batch.output.cpy(creator.m_output);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  normalize_string - escape a string for XML;
+//  unlike xml_normalize_string, the result lives
+//  in this creator, so creators on different
+//  threads don't share a buffer
+//-------------------------------------------------
+
+const char *info_xml_creator::normalize_string(const char *string)
+{
+	m_normalized.reset();
+	if (string == NULL)
+		return m_normalized;
+
+	// copy runs of plain characters, escaping the rest
+	const char *start = string;
+	for ( ; *string != 0; string++)
+	{
+		const char *escape;
+		switch (*string)
+		{
+			case '\"': escape = "&quot;"; break;
+			case '&': escape = "&amp;"; break;
+			case '<': escape = "&lt;"; break;
+			case '>': escape = "&gt;"; break;
+			default: continue;
+		}
+		m_normalized.cat(start, string - start).cat(escape);
+		start = string + 1;
+	}
+	return m_normalized.cat(start, string - start);
 }
 
 
@@ -245,8 +335,8 @@ void info_xml_creator::output_one()
 		portlist.append(*device, errors);
 
 	// print the header and the game name
-	fprintf(m_output, "\t<%s",emulator_info::get_xml_top());
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(driver.name));
+	m_output.catprintf("\t<%s",emulator_info::get_xml_top());
+	m_output.catprintf(" name=\"%s\"", normalize_string(driver.name));
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.source_file, '/');
@@ -254,38 +344,38 @@ void info_xml_creator::output_one()
 		start = strrchr(driver.source_file, '\\');
 	if (start == NULL)
 		start = driver.source_file - 1;
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(start + 1));
+	m_output.catprintf(" sourcefile=\"%s\"", normalize_string(start + 1));
 
 	// append bios and runnable flags
 	if (driver.flags & GAME_IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+		m_output.catprintf(" isbios=\"yes\"");
 	if (driver.flags & GAME_NO_STANDALONE)
-		fprintf(m_output, " runnable=\"no\"");
+		m_output.catprintf(" runnable=\"no\"");
 	if (driver.flags & GAME_MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+		m_output.catprintf(" ismechanical=\"yes\"");
 
 	// display clone information
 	int clone_of = m_drivlist.find(driver.parent);
 	if (clone_of != -1 && !(m_drivlist.driver(clone_of).flags & GAME_IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		m_output.catprintf(" cloneof=\"%s\"", normalize_string(m_drivlist.driver(clone_of).name));
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		m_output.catprintf(" romof=\"%s\"", normalize_string(m_drivlist.driver(clone_of).name));
 
 	// display sample information and close the game tag
 	output_sampleof();
-	fprintf(m_output, ">\n");
+	m_output.catprintf(">\n");
 
 	// output game description
 	if (driver.description != NULL)
-		fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(driver.description));
+		m_output.catprintf("\t\t<description>%s</description>\n", normalize_string(driver.description));
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != NULL && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", xml_normalize_string(driver.year));
+		m_output.catprintf("\t\t<year>%s</year>\n", normalize_string(driver.year));
 
 	// print the manufacturer information
 	if (driver.manufacturer != NULL)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", xml_normalize_string(driver.manufacturer));
+		m_output.catprintf("\t\t<manufacturer>%s</manufacturer>\n", normalize_string(driver.manufacturer));
 
 	// now print various additional information
 	output_bios();
@@ -307,7 +397,7 @@ void info_xml_creator::output_one()
 	output_ramoptions();
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n",emulator_info::get_xml_top());
+	m_output.catprintf("\t</%s>\n",emulator_info::get_xml_top());
 }
 
 
@@ -339,14 +429,14 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s", emulator_info::get_xml_top());
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(device.shortname()));
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(device.source()));
-	fprintf(m_output, " isdevice=\"yes\"");
-	fprintf(m_output, " runnable=\"no\"");
+	m_output.catprintf("\t<%s", emulator_info::get_xml_top());
+	m_output.catprintf(" name=\"%s\"", normalize_string(device.shortname()));
+	m_output.catprintf(" sourcefile=\"%s\"", normalize_string(device.source()));
+	m_output.catprintf(" isdevice=\"yes\"");
+	m_output.catprintf(" runnable=\"no\"");
 	output_sampleof();
-	fprintf(m_output, ">\n");
-	fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(device.name()));
+	m_output.catprintf(">\n");
+	m_output.catprintf("\t\t<description>%s</description>\n", normalize_string(device.name()));
 
 	output_rom(device);
 
@@ -364,7 +454,7 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 	output_adjusters(portlist);
 	output_images(device, devtag);
 	output_slots(device, devtag);
-	fprintf(m_output, "\t</%s>\n", emulator_info::get_xml_top());
+	m_output.catprintf("\t</%s>\n", emulator_info::get_xml_top());
 }
 
 
@@ -430,7 +520,7 @@ void info_xml_creator::output_device_roms()
 	device_iterator deviter(m_drivlist.config().root_device());
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 		if (device->owner() != NULL && device->shortname()!= NULL && strlen(device->shortname())!=0)
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", xml_normalize_string(device->shortname()));
+			m_output.catprintf("\t\t<device_ref name=\"%s\"/>\n", normalize_string(device->shortname()));
 }
 
 
@@ -448,7 +538,7 @@ void info_xml_creator::output_sampleof()
 		samples_iterator sampiter(*device);
 		if (sampiter.altbasename() != NULL)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", xml_normalize_string(sampiter.altbasename()));
+			m_output.catprintf(" sampleof=\"%s\"", normalize_string(sampiter.altbasename()));
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -473,12 +563,12 @@ void info_xml_creator::output_bios()
 		if (ROMENTRY_ISSYSTEM_BIOS(rom))
 		{
 			// output extracted name and descriptions
-			fprintf(m_output, "\t\t<biosset");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(ROM_GETNAME(rom)));
-			fprintf(m_output, " description=\"%s\"", xml_normalize_string(ROM_GETHASHDATA(rom)));
+			m_output.catprintf("\t\t<biosset");
+			m_output.catprintf(" name=\"%s\"", normalize_string(ROM_GETNAME(rom)));
+			m_output.catprintf(" description=\"%s\"", normalize_string(ROM_GETHASHDATA(rom)));
 			if (ROM_GETBIOSFLAGS(rom) == 1)
-				fprintf(m_output, " default=\"yes\"");
-			fprintf(m_output, "/>\n");
+				m_output.catprintf(" default=\"yes\"");
+			m_output.catprintf("/>\n");
 		}
 }
 
@@ -542,11 +632,11 @@ void info_xml_creator::output_rom(device_t &device)
 
 				// add name, merge, bios, and size tags */
 				if (name != NULL && name[0] != 0)
-					output.catprintf(" name=\"%s\"", xml_normalize_string(name));
+					output.catprintf(" name=\"%s\"", normalize_string(name));
 				if (merge_name != NULL)
-					output.catprintf(" merge=\"%s\"", xml_normalize_string(merge_name));
+					output.catprintf(" merge=\"%s\"", normalize_string(merge_name));
 				if (bios_name[0] != 0)
-					output.catprintf(" bios=\"%s\"", xml_normalize_string(bios_name));
+					output.catprintf(" bios=\"%s\"", normalize_string(bios_name));
 				if (!is_disk)
 					output.catprintf(" size=\"%d\"", rom_file_size(rom));
 
@@ -580,7 +670,7 @@ void info_xml_creator::output_rom(device_t &device)
 
 				output.cat("/>\n");
 
-				fprintf(m_output, "%s", output.cstr());
+				m_output.cat(output);
 			}
 		}
 }
@@ -606,7 +696,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", xml_normalize_string(samplename));
+			m_output.catprintf("\t\t<sample name=\"%s\"/>\n", normalize_string(samplename));
 		}
 	}
 }
@@ -628,12 +718,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			astring newtag(exec->device().tag()), oldtag(":");
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(exec->device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec->device().clock());
-			fprintf(m_output, "/>\n");
+			m_output.catprintf("\t\t<chip");
+			m_output.catprintf(" type=\"cpu\"");
+			m_output.catprintf(" tag=\"%s\"", normalize_string(newtag));
+			m_output.catprintf(" name=\"%s\"", normalize_string(exec->device().name()));
+			m_output.catprintf(" clock=\"%d\"", exec->device().clock());
+			m_output.catprintf("/>\n");
 		}
 	}
 
@@ -646,13 +736,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			astring newtag(sound->device().tag()), oldtag(":");
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(sound->device().name()));
+			m_output.catprintf("\t\t<chip");
+			m_output.catprintf(" type=\"audio\"");
+			m_output.catprintf(" tag=\"%s\"", normalize_string(newtag));
+			m_output.catprintf(" name=\"%s\"", normalize_string(sound->device().name()));
 			if (sound->device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound->device().clock());
-			fprintf(m_output, "/>\n");
+				m_output.catprintf(" clock=\"%d\"", sound->device().clock());
+			m_output.catprintf("/>\n");
 		}
 	}
 }
@@ -674,43 +764,43 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			astring newtag(screendev->tag()), oldtag(":");
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
-			fprintf(m_output, "\t\t<display");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
+			m_output.catprintf("\t\t<display");
+			m_output.catprintf(" tag=\"%s\"", normalize_string(newtag));
 
 			switch (screendev->screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    m_output.catprintf(" type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    m_output.catprintf(" type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       m_output.catprintf(" type=\"lcd\"");     break;
+				default:                    m_output.catprintf(" type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (m_drivlist.driver().flags & ORIENTATION_MASK)
 			{
 				case ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"0\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"180\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\"");
+					m_output.catprintf(" rotate=\"180\"");
 					break;
 				case ORIENTATION_SWAP_XY:
-					fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"90\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"90\"");
+					m_output.catprintf(" rotate=\"90\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\"");
+					m_output.catprintf(" rotate=\"270\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+					m_output.catprintf(" rotate=\"270\" flipx=\"yes\"");
 					break;
 				default:
-					fprintf(m_output, " rotate=\"0\"");
+					m_output.catprintf(" rotate=\"0\"");
 					break;
 			}
 
@@ -718,12 +808,12 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			if (screendev->screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev->visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				m_output.catprintf(" width=\"%d\"", visarea.width());
+				m_output.catprintf(" height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
+			m_output.catprintf(" refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -731,15 +821,15 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			{
 				int pixclock = screendev->width() * screendev->height() * ATTOSECONDS_TO_HZ(screendev->refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev->width());
-				fprintf(m_output, " hbend=\"%d\"", screendev->visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev->visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev->height());
-				fprintf(m_output, " vbend=\"%d\"", screendev->visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev->visible_area().max_y+1);
+				m_output.catprintf(" pixclock=\"%d\"", pixclock);
+				m_output.catprintf(" htotal=\"%d\"", screendev->width());
+				m_output.catprintf(" hbend=\"%d\"", screendev->visible_area().min_x);
+				m_output.catprintf(" hbstart=\"%d\"", screendev->visible_area().max_x+1);
+				m_output.catprintf(" vtotal=\"%d\"", screendev->height());
+				m_output.catprintf(" vbend=\"%d\"", screendev->visible_area().min_y);
+				m_output.catprintf(" vbstart=\"%d\"", screendev->visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			m_output.catprintf(" />\n");
 		}
 	}
 }
@@ -760,7 +850,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == NULL)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	m_output.catprintf("\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -969,17 +1059,17 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 		}
 
 	// output the basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	m_output.catprintf("\t\t<input");
+	m_output.catprintf(" players=\"%d\"", nplayer);
 	if (nbutton != 0)
-		fprintf(m_output, " buttons=\"%d\"", nbutton);
+		m_output.catprintf(" buttons=\"%d\"", nbutton);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		m_output.catprintf(" coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		m_output.catprintf(" service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		m_output.catprintf(" tilt=\"yes\"");
+	m_output.catprintf(">\n");
 
 	// output the joystick types
 	if (joytype[1]==0 && joytype[2]!=0) { joytype[1] = joytype[2]; joytype[2] = 0; }
@@ -988,7 +1078,7 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 	if (joytype[0] != 0)
 	{
 		const char *joys = (joytype[2]!=0) ? "triple" : (joytype[1]!=0) ? "double" : "";
-		fprintf(m_output, "\t\t\t<control type=\"%sjoy\"", joys);
+		m_output.catprintf("\t\t\t<control type=\"%sjoy\"", joys);
 		for (int lp=0; lp<3 && joytype[lp]!=0; lp++)
 		{
 			const char *plural = (lp==2) ? "3" : (lp==1) ? "2" : "";
@@ -1020,46 +1110,46 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 					ways = "strange2";
 					break;
 			}
-			fprintf(m_output, " ways%s=\"%s\"", plural,ways);
+			m_output.catprintf(" ways%s=\"%s\"", plural,ways);
 		}
-		fprintf(m_output, "/>\n");
+		m_output.catprintf("/>\n");
 	}
 
 	// output analog types
 	for (int type = 0; type < ANALOG_TYPE_COUNT; type++)
 		if (control_info[type].type != NULL)
 		{
-			fprintf(m_output, "\t\t\t<control type=\"%s\"", xml_normalize_string(control_info[type].type));
+			m_output.catprintf("\t\t\t<control type=\"%s\"", normalize_string(control_info[type].type));
 			if (control_info[type].min != 0 || control_info[type].max != 0)
 			{
-				fprintf(m_output, " minimum=\"%d\"", control_info[type].min);
-				fprintf(m_output, " maximum=\"%d\"", control_info[type].max);
+				m_output.catprintf(" minimum=\"%d\"", control_info[type].min);
+				m_output.catprintf(" maximum=\"%d\"", control_info[type].max);
 			}
 			if (control_info[type].sensitivity != 0)
-				fprintf(m_output, " sensitivity=\"%d\"", control_info[type].sensitivity);
+				m_output.catprintf(" sensitivity=\"%d\"", control_info[type].sensitivity);
 			if (control_info[type].keydelta != 0)
-				fprintf(m_output, " keydelta=\"%d\"", control_info[type].keydelta);
+				m_output.catprintf(" keydelta=\"%d\"", control_info[type].keydelta);
 			if (control_info[type].reverse)
-				fprintf(m_output, " reverse=\"yes\"");
+				m_output.catprintf(" reverse=\"yes\"");
 
-			fprintf(m_output, "/>\n");
+			m_output.catprintf("/>\n");
 		}
 
 	// output keypad and keyboard
 	if (keypad)
-		fprintf(m_output, "\t\t\t<control type=\"keypad\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"keypad\"/>\n");
 	if (keyboard)
-		fprintf(m_output, "\t\t\t<control type=\"keyboard\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"keyboard\"/>\n");
 
 	// misc
 	if (mahjong)
-		fprintf(m_output, "\t\t\t<control type=\"mahjong\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"mahjong\"/>\n");
 	if (hanafuda)
-		fprintf(m_output, "\t\t\t<control type=\"hanafuda\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"hanafuda\"/>\n");
 	if (gambling)
-		fprintf(m_output, "\t\t\t<control type=\"gambling\"/>\n");
+		m_output.catprintf("\t\t\t<control type=\"gambling\"/>\n");
 
-	fprintf(m_output, "\t\t</input>\n");
+	m_output.catprintf("\t\t</input>\n");
 }
 
 
@@ -1081,20 +1171,20 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
 				// output the switch name information
-				astring normalized_field_name(xml_normalize_string(field->name()));
-				astring normalized_newtag(xml_normalize_string(newtag));
+				astring normalized_field_name(normalize_string(field->name()));
+				astring normalized_newtag(normalize_string(newtag));
 				output.catprintf("\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.cstr(), normalized_newtag.cstr(), field->mask());
 
 				// loop over settings
 				for (ioport_setting *setting = field->first_setting(); setting != NULL; setting = setting->next())
 				{
-					output.catprintf("\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, xml_normalize_string(setting->name()), setting->value(), setting->value() == field->defvalue() ? " default=\"yes\"" : "");
+					output.catprintf("\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, normalize_string(setting->name()), setting->value(), setting->value() == field->defvalue() ? " default=\"yes\"" : "");
 				}
 
 				// terminate the switch entry
 				output.catprintf("\t\t</%s>\n", outertag);
 
-				fprintf(m_output, "%s", output.cstr());
+				m_output.cat(output);
 			}
 }
 
@@ -1107,14 +1197,14 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (ioport_port *port = portlist.first(); port != NULL; port = port->next())
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n",port->tag());
+		m_output.catprintf("\t\t<port tag=\"%s\">\n",port->tag());
 		for (ioport_field *field = port->first_field(); field != NULL; field = field->next())
 		{
 			if(field->is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n",field->mask());
+				m_output.catprintf("\t\t\t<analog mask=\"%u\"/>\n",field->mask());
 		}
 		// close element
-		fprintf(m_output,"\t\t</port>\n");
+		m_output.catprintf("\t\t</port>\n");
 	}
 
 }
@@ -1130,7 +1220,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 	for (ioport_port *port = portlist.first(); port != NULL; port = port->next())
 		for (ioport_field *field = port->first_field(); field != NULL; field = field->next())
 			if (field->type() == IPT_ADJUSTER)
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", xml_normalize_string(field->name()), field->defvalue());
+				m_output.catprintf("\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", normalize_string(field->name()), field->defvalue());
 }
 
 
@@ -1140,7 +1230,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver()
 {
-	fprintf(m_output, "\t\t<driver");
+	m_output.catprintf("\t\t<driver");
 
 	/* The status entry is an hint for frontend authors */
 	/* to select working and not working games without */
@@ -1151,48 +1241,48 @@ void info_xml_creator::output_driver()
 	/* don't work or have major emulation problems. */
 
 	if (m_drivlist.driver().flags & (GAME_NOT_WORKING | GAME_UNEMULATED_PROTECTION | GAME_NO_SOUND | GAME_WRONG_COLORS | GAME_MECHANICAL))
-		fprintf(m_output, " status=\"preliminary\"");
+		m_output.catprintf(" status=\"preliminary\"");
 	else if (m_drivlist.driver().flags & (GAME_IMPERFECT_COLORS | GAME_IMPERFECT_SOUND | GAME_IMPERFECT_GRAPHICS))
-		fprintf(m_output, " status=\"imperfect\"");
+		m_output.catprintf(" status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		m_output.catprintf(" status=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		m_output.catprintf(" emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		m_output.catprintf(" emulation=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_WRONG_COLORS)
-		fprintf(m_output, " color=\"preliminary\"");
+		m_output.catprintf(" color=\"preliminary\"");
 	else if (m_drivlist.driver().flags & GAME_IMPERFECT_COLORS)
-		fprintf(m_output, " color=\"imperfect\"");
+		m_output.catprintf(" color=\"imperfect\"");
 	else
-		fprintf(m_output, " color=\"good\"");
+		m_output.catprintf(" color=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_NO_SOUND)
-		fprintf(m_output, " sound=\"preliminary\"");
+		m_output.catprintf(" sound=\"preliminary\"");
 	else if (m_drivlist.driver().flags & GAME_IMPERFECT_SOUND)
-		fprintf(m_output, " sound=\"imperfect\"");
+		m_output.catprintf(" sound=\"imperfect\"");
 	else
-		fprintf(m_output, " sound=\"good\"");
+		m_output.catprintf(" sound=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_IMPERFECT_GRAPHICS)
-		fprintf(m_output, " graphic=\"imperfect\"");
+		m_output.catprintf(" graphic=\"imperfect\"");
 	else
-		fprintf(m_output, " graphic=\"good\"");
+		m_output.catprintf(" graphic=\"good\"");
 
 	if (m_drivlist.driver().flags & GAME_NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		m_output.catprintf(" cocktail=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & GAME_UNEMULATED_PROTECTION)
-		fprintf(m_output, " protection=\"preliminary\"");
+		m_output.catprintf(" protection=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & GAME_SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		m_output.catprintf(" savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		m_output.catprintf(" savestate=\"unsupported\"");
 
-	fprintf(m_output, "/>\n");
+	m_output.catprintf("/>\n");
 }
 
 
@@ -1212,42 +1302,42 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", xml_normalize_string(imagedev->image_type_name()));
+			m_output.catprintf("\t\t<device type=\"%s\"", normalize_string(imagedev->image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev->device().tag())
-				fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag));
+				m_output.catprintf(" tag=\"%s\"", normalize_string(newtag));
 
 			// is this device mandatory?
 			if (imagedev->must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				m_output.catprintf(" mandatory=\"1\"");
 
 			if (imagedev->image_interface() && imagedev->image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", xml_normalize_string(imagedev->image_interface()));
+				m_output.catprintf(" interface=\"%s\"", normalize_string(imagedev->image_interface()));
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			m_output.catprintf(">\n");
 
 			const char *name = imagedev->instance_name();
 			const char *shortname = imagedev->brief_instance_name();
 
-			fprintf(m_output, "\t\t\t<instance");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(name));
-			fprintf(m_output, " briefname=\"%s\"", xml_normalize_string(shortname));
-			fprintf(m_output, "/>\n");
+			m_output.catprintf("\t\t\t<instance");
+			m_output.catprintf(" name=\"%s\"", normalize_string(name));
+			m_output.catprintf(" briefname=\"%s\"", normalize_string(shortname));
+			m_output.catprintf("/>\n");
 
 			astring extensions(imagedev->file_extensions());
 
 			char *ext = strtok((char *)extensions.cstr(), ",");
 			while (ext != NULL)
 			{
-				fprintf(m_output, "\t\t\t<extension");
-				fprintf(m_output, " name=\"%s\"", xml_normalize_string(ext));
-				fprintf(m_output, "/>\n");
+				m_output.catprintf("\t\t\t<extension");
+				m_output.catprintf(" name=\"%s\"", normalize_string(ext));
+				m_output.catprintf("/>\n");
 				ext = strtok(NULL, ",");
 			}
 
-			fprintf(m_output, "\t\t</device>\n");
+			m_output.catprintf("\t\t</device>\n");
 		}
 	}
 }
@@ -1270,11 +1360,11 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 			newtag.substr(newtag.find(oldtag.cat(root_tag)) + oldtag.len());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<slot name=\"%s\">\n", xml_normalize_string(newtag));
+			m_output.catprintf("\t\t<slot name=\"%s\">\n", normalize_string(newtag));
 
 			/*
 			 if (slot->slot_interface()[0])
-			 fprintf(m_output, " interface=\"%s\"", xml_normalize_string(slot->slot_interface()));
+			 m_output.catprintf(" interface=\"%s\"", normalize_string(slot->slot_interface()));
 			 */
 
 			for (const device_slot_option *option = slot->first_option(); option != NULL; option = option->next())
@@ -1285,20 +1375,20 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 					if (!dev->configured())
 						dev->config_complete();
 
-					fprintf(m_output, "\t\t\t<slotoption");
-					fprintf(m_output, " name=\"%s\"", xml_normalize_string(option->name()));
-					fprintf(m_output, " devname=\"%s\"", xml_normalize_string(dev->shortname()));
+					m_output.catprintf("\t\t\t<slotoption");
+					m_output.catprintf(" name=\"%s\"", normalize_string(option->name()));
+					m_output.catprintf(" devname=\"%s\"", normalize_string(dev->shortname()));
 					if (slot->default_option())
 					{
 						if (strcmp(slot->default_option(),option->name())==0)
-							fprintf(m_output, " default=\"yes\"");
+							m_output.catprintf(" default=\"yes\"");
 					}
-					fprintf(m_output, "/>\n");
+					m_output.catprintf("/>\n");
 					const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), "dummy");
 				}
 			}
 
-			fprintf(m_output, "\t\t</slot>\n");
+			m_output.catprintf("\t\t</slot>\n");
 		}
 	}
 }
@@ -1314,12 +1404,12 @@ void info_xml_creator::output_software_list()
 	software_list_device_iterator iter(m_drivlist.config().root_device());
 	for (const software_list_device *swlist = iter.first(); swlist != NULL; swlist = iter.next())
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" ", swlist->list_name());
-		fprintf(m_output, "status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		m_output.catprintf("\t\t<softwarelist name=\"%s\" ", swlist->list_name());
+		m_output.catprintf("status=\"%s\" ", (swlist->list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist->filter()) {
-			fprintf(m_output, "filter=\"%s\" ", swlist->filter());
+			m_output.catprintf("filter=\"%s\" ", swlist->filter());
 		}
-		fprintf(m_output, "/>\n");
+		m_output.catprintf("/>\n");
 	}
 }
 
@@ -1335,7 +1425,7 @@ void info_xml_creator::output_ramoptions()
 	ram_device_iterator iter(m_drivlist.config().root_device());
 	for (const ram_device *ram = iter.first(); ram != NULL; ram = iter.next())
 	{
-		fprintf(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
+		m_output.catprintf("\t\t<ramoption default=\"1\">%u</ramoption>\n", ram->default_size());
 
 		if (ram->extra_options() != NULL)
 		{
@@ -1344,7 +1434,7 @@ void info_xml_creator::output_ramoptions()
 			{
 				astring option;
 				option.cpysubstr(options, start, (end == -1) ? -1 : end - start);
-				fprintf(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option));
+				m_output.catprintf("\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option));
 				if (end == -1)
 					break;
 			}
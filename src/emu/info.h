@@ -31,6 +31,26 @@ public:
 	void output(FILE *out);
 
 private:
+	// drivers formatted per work item, and work items in flight at once
+	static const int BATCH_DRIVERS = 16;
+	static const int BATCHES_IN_FLIGHT = 32;
+
+	// a run of consecutive drivers formatted together on a worker
+	struct driver_batch
+	{
+		driver_batch() : options(NULL), drivers(NULL), count(0), item(NULL) { }
+
+		emu_options *       options;            // options for building configs
+		const int *         drivers;            // driver indexes to output
+		int                 count;              // number of drivers
+		osd_work_item *     item;               // work item, while in flight
+		astring             output;             // formatted XML
+	};
+
+	// parallel output
+	static void *output_batch(void *param, int threadid);
+	const char *normalize_string(const char *string);
+
 	// internal helper
 	void output_one();
 	void output_sampleof();
@@ -57,7 +77,8 @@ private:
 	const char *get_merge_name(const hash_collection &romhashes);
 
 	// internal state
-	FILE *                  m_output;
+	astring                 m_output;
+	astring                 m_normalized;
 	driver_enumerator &     m_drivlist;
 	emu_options             m_lookup_options;
 
@@ -4131,6 +4131,8 @@ memory_region::memory_region(running_machine &machine, const char *name, UINT32
 		m_next(NULL),
 		m_name(name),
 		m_buffer(length),
+		m_mapped(NULL),
+		m_length(length),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
@@ -4139,6 +4141,33 @@ memory_region::memory_region(running_machine &machine, const char *name, UINT32
 }
 
 
+//-------------------------------------------------
+//  ~memory_region - destructor
+//-------------------------------------------------
+
+memory_region::~memory_region()
+{
+	if (m_mapped != NULL)
+		osd_unmap(m_mapped, m_length);
+}
+
+
+//-------------------------------------------------
+//  set_mapping - replace the region's buffer with
+//  a copy-on-write mapping (from osd_map) of a
+//  file covering the whole region; the region
+//  owns the mapping from then on
+//-------------------------------------------------
+
+void memory_region::set_mapping(void *base)
+{
+	if (m_mapped != NULL)
+		osd_unmap(m_mapped, m_length);
+	m_mapped = reinterpret_cast<UINT8 *>(base);
+	m_buffer.reset();
+}
+
+
 
 //**************************************************************************
 //  HANDLER ENTRY
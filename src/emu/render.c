@@ -228,7 +228,9 @@ void render_primitive::reset()
 //-------------------------------------------------
 
 render_primitive_list::render_primitive_list()
-	: m_lock(osd_lock_alloc())
+	: m_content_serial(0),
+		m_unchanged(false),
+		m_lock(osd_lock_alloc())
 {
 }
 
@@ -300,6 +302,8 @@ void render_primitive_list::release_all()
 	acquire_lock();
 	m_primitive_allocator.reclaim_all(m_primlist);
 	m_reference_allocator.reclaim_all(m_reflist);
+	m_content_serial = 0;
+	m_unchanged = false;
 	release_lock();
 }
 
@@ -319,6 +323,44 @@ void render_primitive_list::append_or_return(render_primitive &prim, bool clippe
 }
 
 
+//-------------------------------------------------
+//  matches - return true if this list would
+//  produce the same output as a previous one;
+//  texture sequence IDs are ignored, since the
+//  content serials cover any change in the
+//  underlying bitmaps and palettes
+//-------------------------------------------------
+
+bool render_primitive_list::matches(const render_primitive_list &prevlist) const
+{
+	// the referenced texture content must be the same
+	if (m_content_serial != prevlist.m_content_serial || m_primlist.count() != prevlist.m_primlist.count())
+		return false;
+
+	// compare primitive by primitive
+	const render_primitive *prevprim = prevlist.first();
+	for (const render_primitive *prim = first(); prim != NULL; prim = prim->next(), prevprim = prevprim->next())
+	{
+		if (prim->type != prevprim->type || prim->flags != prevprim->flags || prim->width != prevprim->width)
+			return false;
+		if (memcmp(&prim->bounds, &prevprim->bounds, sizeof(prim->bounds)) != 0 || memcmp(&prim->color, &prevprim->color, sizeof(prim->color)) != 0)
+			return false;
+		if (prim->texture.base != prevprim->texture.base)
+			return false;
+		if (prim->texture.base != NULL)
+		{
+			if (prim->texture.rowpixels != prevprim->texture.rowpixels || prim->texture.width != prevprim->texture.width ||
+				prim->texture.height != prevprim->texture.height || prim->texture.palette != prevprim->texture.palette ||
+				prim->texture.osddata != prevprim->texture.osddata)
+				return false;
+			if (memcmp(&prim->texcoords, &prevprim->texcoords, sizeof(prim->texcoords)) != 0)
+				return false;
+		}
+	}
+	return true;
+}
+
+
 
 //**************************************************************************
 //  RENDER TEXTURE
@@ -336,7 +378,8 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(NULL),
 		m_param(NULL),
-		m_curseq(0)
+		m_curseq(0),
+		m_serial(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
@@ -415,6 +458,7 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
 	m_format = format;
+	m_serial++;
 
 	// invalidate all scaled versions
 	for (int scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
@@ -459,6 +503,11 @@ bool render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 
 	texinfo.osddata = m_osddata;
 
+	// note the state of the source for change detection
+	primlist.add_content_serial(m_serial);
+	if (m_bitmap != NULL && m_bitmap->palette() != NULL)
+		primlist.add_content_serial(m_bitmap->palette()->serial());
+
 	// are we scaler-free? if so, just return the source bitmap
 	const rgb_t *palbase = (m_format == TEXFORMAT_PALETTE16 || m_format == TEXFORMAT_PALETTEA16) ? m_bitmap->palette()->entry_list_adjusted() : NULL;
 	if (m_scaler == NULL || (m_bitmap != NULL && swidth == dwidth && sheight == dheight))
@@ -921,7 +970,9 @@ render_target::render_target(render_manager &manager, const char *layoutfile, UI
 		m_base_view(NULL),
 		m_base_orientation(ROT0),
 		m_maxtexwidth(65536),
-		m_maxtexheight(65536)
+		m_maxtexheight(65536),
+		m_frames_built(0),
+		m_frames_unchanged(0)
 {
 	// determine the base layer configuration based on options
 	m_base_layerconfig.set_backdrops_enabled(manager.machine().options().use_backdrops());
@@ -1261,6 +1312,11 @@ render_primitive_list &render_target::get_primitives()
 	if (m_base_view == NULL)
 		m_base_view = m_curview;
 
+	// drop least recently used element states before building; nothing references them yet
+	for (layout_file *file = m_filelist.first(); file != NULL; file = file->next())
+		for (layout_element *element = file->first_element(); element != NULL; element = element->next())
+			element->trim_textures();
+
 	// switch to the next primitive list
 	render_primitive_list &list = m_primlist[m_listindex];
 	m_listindex = (m_listindex + 1) % ARRAY_LENGTH(m_primlist);
@@ -1378,6 +1434,12 @@ render_primitive_list &render_target::get_primitives()
 
 	// optimize the list before handing it off
 	add_clear_and_optimize_primitive_list(list);
+
+	// flag the list if nothing changed since the last one, so the OSD can skip redrawing
+	list.m_unchanged = list.matches(m_primlist[(m_listindex + NUM_PRIMLISTS - 2) % NUM_PRIMLISTS]);
+	m_frames_built++;
+	if (list.m_unchanged)
+		m_frames_unchanged++;
 	list.release_lock();
 	return list;
 }
@@ -1623,6 +1685,14 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 	// first update the palette for the container, if it is dirty
 	container.update_palette();
 
+	// any brightness/contrast/gamma adjustment changes the lookup tables handed to the OSD
+	if (container.has_brightness_contrast_gamma_changes())
+	{
+		list.add_content_serial((UINT32)(container.m_user.m_brightness * 65536.0f));
+		list.add_content_serial((UINT32)(container.m_user.m_contrast * 65536.0f));
+		list.add_content_serial((UINT32)(container.m_user.m_gamma * 65536.0f));
+	}
+
 	// compute the clip rect
 	render_bounds cliprect;
 	cliprect.x0 = xform.xoffs;
@@ -1831,8 +1901,20 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 
 		// get the scaled texture and append it
 		bool clipped = true;
+		UINT64 renders = m_manager.m_element_renders;
+		m_manager.m_element_requests++;
 		if (texture->get_scaled(width, height, prim->texture, list))
 		{
+			// if we had to render this state at a new size, render the other states of small elements
+			// (lamps and the like) right away so that toggling them later doesn't cost anything
+			if (renders != m_manager.m_element_renders && element.maxstate() < PREWARM_MAX_STATES)
+				for (int curstate = 0; curstate <= element.maxstate(); curstate++)
+					if (curstate != state)
+					{
+						render_texinfo texinfo;
+						element.state_texture(curstate)->get_scaled(width, height, texinfo, list);
+					}
+
 			// compute the clip rect
 			render_bounds cliprect;
 			cliprect.x0 = render_round_nearest(xform.xoffs);
@@ -2375,6 +2457,8 @@ render_manager::render_manager(running_machine &machine)
 	: m_machine(machine),
 		m_ui_target(NULL),
 		m_live_textures(0),
+		m_element_requests(0),
+		m_element_renders(0),
 		m_ui_container(global_alloc(render_container(*this)))
 {
 	// register callbacks
@@ -352,6 +352,7 @@ private:
 class render_primitive_list
 {
 	friend class render_target;
+	friend class render_texture;
 
 	// construction/destruction
 	render_primitive_list();
@@ -360,6 +361,7 @@ class render_primitive_list
 public:
 	// getters
 	render_primitive *first() const { return m_primlist.first(); }
+	bool unchanged() const { return m_unchanged; }
 
 	// lock management
 	void acquire_lock() { osd_lock_acquire(m_lock); }
@@ -375,6 +377,8 @@ private:
 	void release_all();
 	void append(render_primitive &prim) { append_or_return(prim, false); }
 	void append_or_return(render_primitive &prim, bool clipped);
+	void add_content_serial(UINT32 serial) { m_content_serial = (m_content_serial ^ serial) * 16777619; }
+	bool matches(const render_primitive_list &prevlist) const;
 
 	// a reference is an abstract reference to an internal object of some sort
 	class reference
@@ -392,6 +396,8 @@ private:
 	fixed_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
 	fixed_allocator<reference> m_reference_allocator;       // allocator for references
 
+	UINT32              m_content_serial;                   // hash of the content serials of all referenced textures
+	bool                m_unchanged;                        // true if identical to the previous list for the target
 	osd_lock *          m_lock;                             // lock to protect list accesses
 };
 
@@ -457,6 +463,7 @@ private:
 	texture_scaler_func m_scaler;                   // scaling callback
 	void *              m_param;                    // scaling callback parameter
 	UINT32              m_curseq;                   // current sequence number
+	UINT32              m_serial;                   // content serial, bumped each time a bitmap is set
 	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
 };
 
@@ -609,6 +616,8 @@ public:
 	bool hidden() const { return ((m_flags & RENDER_CREATE_HIDDEN) != 0); }
 	bool is_ui_target() const;
 	int index() const;
+	UINT32 frames_built() const { return m_frames_built; }
+	UINT32 frames_unchanged() const { return m_frames_unchanged; }
 
 	// setters
 	void set_bounds(INT32 width, INT32 height, float pixel_aspect = 0);
@@ -686,6 +695,7 @@ private:
 
 	// constants
 	static const int NUM_PRIMLISTS = 3;
+	static const int PREWARM_MAX_STATES = 16;
 	static const int MAX_CLEAR_EXTENTS = 1000;
 
 	// internal state
@@ -711,6 +721,8 @@ private:
 	simple_list<render_container> m_debug_containers;   // list of debug containers
 	INT32                   m_clear_extent_count;       // number of clear extents
 	INT32                   m_clear_extents[MAX_CLEAR_EXTENTS]; // array of clear extents
+	UINT32                  m_frames_built;             // number of primitive lists built
+	UINT32                  m_frames_unchanged;         // number of those identical to the previous one
 
 	static render_screen_list s_empty_screen_list;
 };
@@ -753,6 +765,11 @@ public:
 	render_texture *texture_alloc(texture_scaler_func scaler = NULL, void *param = NULL);
 	void texture_free(render_texture *texture);
 
+	// layout element texture statistics
+	UINT64 element_requests() const { return m_element_requests; }
+	UINT64 element_renders() const { return m_element_renders; }
+	void element_rendered() { m_element_renders++; }
+
 	// fonts
 	render_font *font_alloc(const char *filename = NULL);
 	void font_free(render_font *font);
@@ -779,6 +796,8 @@ private:
 	// texture lists
 	UINT32                          m_live_textures;    // number of live textures
 	fixed_allocator<render_texture> m_texture_allocator;// texture allocator
+	UINT64                          m_element_requests; // number of layout element textures drawn
+	UINT64                          m_element_renders;  // number of layout element states rendered
 
 	// containers for the UI and for screens
 	render_container *              m_ui_container;     // UI container
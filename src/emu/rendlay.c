@@ -403,7 +403,9 @@ layout_element::layout_element(running_machine &machine, xml_data_node &elemnode
     : m_next(NULL),
         m_machine(machine),
         m_defstate(0),
-        m_maxstate(0)
+        m_maxstate(0),
+        m_live_textures(0),
+        m_texture_clock(0)
 {
     // extract the name
     const char *name = xml_get_attribute_string_with_subst(machine, elemnode, "name", NULL);
@@ -498,11 +500,52 @@ render_texture *layout_element::state_texture(int state)
         m_elemtex[state].m_element = this;
         m_elemtex[state].m_state = state;
         m_elemtex[state].m_texture = machine().render().texture_alloc(element_scale, &m_elemtex[state]);
+        m_live_textures++;
     }
+    m_elemtex[state].m_lastused = ++m_texture_clock;
     return m_elemtex[state].m_texture;
 }
 
 
+//-------------------------------------------------
+//  trim_textures - free the least recently used
+//  state textures once there are too many; must
+//  only be called while no primitive list under
+//  construction refers to them
+//-------------------------------------------------
+
+static int CLIB_DECL compare_lastused(const void *item1, const void *item2)
+{
+    UINT64 stamp1 = *(const UINT64 *)item1;
+    UINT64 stamp2 = *(const UINT64 *)item2;
+    return (stamp1 < stamp2) ? -1 : (stamp1 > stamp2) ? 1 : 0;
+}
+
+void layout_element::trim_textures()
+{
+    // nothing to do until we exceed the limit
+    if (m_live_textures <= MAX_LIVE_TEXTURES)
+        return;
+
+    // find the oldest request stamp that survives
+    dynamic_array<UINT64> stamps;
+    for (int state = 0; state <= m_maxstate; state++)
+        if (m_elemtex[state].m_texture != NULL)
+            stamps.append(m_elemtex[state].m_lastused);
+    qsort(&stamps[0], stamps.count(), sizeof(stamps[0]), compare_lastused);
+    UINT64 cutoff = stamps[stamps.count() - TRIM_LIVE_TEXTURES];
+
+    // free everything older
+    for (int state = 0; state <= m_maxstate; state++)
+        if (m_elemtex[state].m_texture != NULL && m_elemtex[state].m_lastused < cutoff)
+        {
+            machine().render().texture_free(m_elemtex[state].m_texture);
+            m_elemtex[state].m_texture = NULL;
+            m_live_textures--;
+        }
+}
+
+
 //-------------------------------------------------
 //  element_scale - scale an element by rendering
 //  all the components at the appropriate
@@ -512,6 +555,7 @@ render_texture *layout_element::state_texture(int state)
 void layout_element::element_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param)
 {
     texture *elemtex = (texture *)param;
+    elemtex->m_element->machine().render().element_rendered();
 
     // iterate over components that are part of the current state
     for (component *curcomp = elemtex->m_element->m_complist.first(); curcomp != NULL; curcomp = curcomp->next())
@@ -542,7 +586,8 @@ void layout_element::element_scale(bitmap_argb32 &dest, bitmap_argb32 &source, c
 layout_element::texture::texture()
     : m_element(NULL),
         m_texture(NULL),
-        m_state(0)
+        m_state(0),
+        m_lastused(0)
 {
 }
 
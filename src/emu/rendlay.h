@@ -58,6 +58,9 @@ public:
     int maxstate() const { return m_maxstate; }
     render_texture *state_texture(int state);
 
+    // texture cache management
+    void trim_textures();
+
 private:
     // a component represents an image, rectangle, or disk in an element
     class component
@@ -164,8 +167,13 @@ private:
         layout_element *    m_element;      // pointer back to the element
         render_texture *    m_texture;      // texture for this state
         int                 m_state;        // associated state number
+        UINT64              m_lastused;     // texture clock value when last requested
     };
 
+    // elements with many states (reels, segment displays) only keep the most recently used ones
+    static const int MAX_LIVE_TEXTURES = 512;
+    static const int TRIM_LIVE_TEXTURES = 384;
+
     // internal helpers
     static void element_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param);
 
@@ -177,6 +185,8 @@ private:
     int                 m_defstate;         // default state of this element
     int                 m_maxstate;         // maximum state value for all components
     dynamic_array<texture> m_elemtex;       // array of element textures used for managing the scaled bitmaps
+    int                 m_live_textures;    // number of states with a live texture
+    UINT64              m_texture_clock;    // incremented on every texture request
 };
 
 
@@ -0,0 +1,364 @@
+/***************************************************************************
+
+    rendsamp.h
+
+    Bilinear resampling kernels for render_resample_argb_bitmap_hq.
+
+    Copyright Nicola Salmoria and the MAME Team.
+    Visit http://mamedev.org for licensing and usage restrictions.
+
+****************************************************************************
+
+    These need nothing beyond osdcore.h and rgb_t, so that
+    src/tools/rendbench.c can time the scalar, SSE2 and AVX2 kernels
+    against each other and check that their output is identical.
+
+    All three take the premultiplied R/G/B/A factors (256 = 1.0) that
+    rendutil.c computes from the render_color. The SIMD kernels only
+    handle the opaque case, where a == 256 and r/g/b are all <= 256.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __RENDSAMP_H__
+#define __RENDSAMP_H__
+
+#include "osdcore.h"
+#include "palette.h"
+
+/* use SSE2 on 64-bit implementations, where it can be assumed */
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define RENDSAMP_SSE2           1
+
+/* AVX2 is used when the CPU has it, which needs a compiler that can target it per function */
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || (defined(_MSC_VER) && _MSC_VER >= 1900))
+#define RENDSAMP_AVX2           1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AVX2_TARGET
+#else
+#include <cpuid.h>
+#define AVX2_TARGET             __attribute__((target("avx2")))
+#endif
+#endif
+#endif
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    resample_argb_bitmap_bilinear_c - perform
+    texture sampling via a bilinear filter
+-------------------------------------------------*/
+
+INLINE void resample_argb_bitmap_bilinear_c(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy)
+{
+	UINT32 maxx = swidth << 12, maxy = sheight << 12;
+	UINT32 x, y;
+
+	/* loop over the target vertically */
+	for (y = 0; y < dheight; y++)
+	{
+		UINT32 starty = y * dy;
+
+		/* loop over the target horizontally */
+		for (x = 0; x < dwidth; x++)
+		{
+			UINT32 startx = x * dx;
+			rgb_t pix0, pix1, pix2, pix3;
+			UINT32 sumr, sumg, sumb, suma;
+			UINT32 nextx, nexty;
+			UINT32 curx, cury;
+			UINT32 factor;
+
+			/* adjust start to the center; note that this math will tend to produce */
+			/* negative results on the first pixel, which is why we clamp below */
+			curx = startx + dx / 2 - 0x800;
+			cury = starty + dy / 2 - 0x800;
+
+			/* compute the neighboring pixel */
+			nextx = curx + 0x1000;
+			nexty = cury + 0x1000;
+
+			/* fetch the four relevant pixels */
+			pix0 = pix1 = pix2 = pix3 = 0;
+			if ((INT32)cury >= 0 && cury < maxy && (INT32)curx >= 0 && curx < maxx)
+				pix0 = source[(cury >> 12) * srowpixels + (curx >> 12)];
+			if ((INT32)cury >= 0 && cury < maxy && (INT32)nextx >= 0 && nextx < maxx)
+				pix1 = source[(cury >> 12) * srowpixels + (nextx >> 12)];
+			if ((INT32)nexty >= 0 && nexty < maxy && (INT32)curx >= 0 && curx < maxx)
+				pix2 = source[(nexty >> 12) * srowpixels + (curx >> 12)];
+			if ((INT32)nexty >= 0 && nexty < maxy && (INT32)nextx >= 0 && nextx < maxx)
+				pix3 = source[(nexty >> 12) * srowpixels + (nextx >> 12)];
+
+			/* compute the x/y scaling factors */
+			curx &= 0xfff;
+			cury &= 0xfff;
+
+			/* contributions from pixel 0 (top,left) */
+			factor = (0x1000 - curx) * (0x1000 - cury);
+			sumr = factor * pix0.r();
+			sumg = factor * pix0.g();
+			sumb = factor * pix0.b();
+			suma = factor * pix0.a();
+
+			/* contributions from pixel 1 (top,right) */
+			factor = curx * (0x1000 - cury);
+			sumr += factor * pix1.r();
+			sumg += factor * pix1.g();
+			sumb += factor * pix1.b();
+			suma += factor * pix1.a();
+
+			/* contributions from pixel 2 (bottom,left) */
+			factor = (0x1000 - curx) * cury;
+			sumr += factor * pix2.r();
+			sumg += factor * pix2.g();
+			sumb += factor * pix2.b();
+			suma += factor * pix2.a();
+
+			/* contributions from pixel 3 (bottom,right) */
+			factor = curx * cury;
+			sumr += factor * pix3.r();
+			sumg += factor * pix3.g();
+			sumb += factor * pix3.b();
+			suma += factor * pix3.a();
+
+			/* apply scaling */
+			suma = (suma >> 24) * a / 256;
+			sumr = (sumr >> 24) * r / 256;
+			sumg = (sumg >> 24) * g / 256;
+			sumb = (sumb >> 24) * b / 256;
+
+			/* if we're translucent, add in the destination pixel contribution */
+			if (a < 256)
+			{
+				rgb_t dpix = dest[y * drowpixels + x];
+				suma += dpix.a() * (256 - a);
+				sumr += dpix.r() * (256 - a);
+				sumg += dpix.g() * (256 - a);
+				sumb += dpix.b() * (256 - a);
+			}
+
+			/* store the target pixel, dividing the RGBA values by the overall scale factor */
+			dest[y * drowpixels + x] = rgb_t(suma, sumr, sumg, sumb);
+		}
+	}
+}
+
+
+#ifdef RENDSAMP_SSE2
+
+/*-------------------------------------------------
+    resample_bilinear_fetch - fetch the four
+    pixels around 'curx' from a pair of source
+    rows, either of which may be NULL when it
+    lies outside the source
+-------------------------------------------------*/
+
+INLINE void resample_bilinear_fetch(const UINT32 *row0, const UINT32 *row1, UINT32 curx, UINT32 maxx, UINT32 *pix)
+{
+	UINT32 nextx = curx + 0x1000;
+	bool curvalid = ((INT32)curx >= 0 && curx < maxx);
+	bool nextvalid = ((INT32)nextx >= 0 && nextx < maxx);
+
+	pix[0] = pix[1] = pix[2] = pix[3] = 0;
+	if (row0 != NULL)
+	{
+		if (curvalid) pix[0] = row0[curx >> 12];
+		if (nextvalid) pix[1] = row0[nextx >> 12];
+	}
+	if (row1 != NULL)
+	{
+		if (curvalid) pix[2] = row1[curx >> 12];
+		if (nextvalid) pix[3] = row1[nextx >> 12];
+	}
+}
+
+
+/*-------------------------------------------------
+    resample_argb_bitmap_bilinear_sse2 - SSE2
+    version of the bilinear filter for opaque
+    colors; the two taps in X are combined with
+    a 16-bit multiply-add, and the two rows in Y
+    with a pair of 32-bit multiplies, which gives
+    exactly the same sums as the scalar code
+-------------------------------------------------*/
+
+INLINE void resample_argb_bitmap_bilinear_sse2(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy)
+{
+	UINT32 maxx = swidth << 12, maxy = sheight << 12;
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i scale = _mm_set_epi16(a, r, g, b, a, r, g, b);
+	UINT32 x, y;
+
+	/* loop over the target vertically */
+	for (y = 0; y < dheight; y++)
+	{
+		UINT32 cury = y * dy + dy / 2 - 0x800;
+		UINT32 nexty = cury + 0x1000;
+		UINT32 *d = &dest[y * drowpixels];
+
+		/* determine the two source rows, or NULL if they are out of range */
+		const UINT32 *row0 = ((INT32)cury >= 0 && cury < maxy) ? &source[(cury >> 12) * srowpixels] : NULL;
+		const UINT32 *row1 = ((INT32)nexty >= 0 && nexty < maxy) ? &source[(nexty >> 12) * srowpixels] : NULL;
+
+		/* the Y weights are constant across the row */
+		const __m128i yweight0 = _mm_set1_epi32(0x1000 - (cury & 0xfff));
+		const __m128i yweight1 = _mm_set1_epi32(cury & 0xfff);
+
+		/* loop over the target horizontally */
+		for (x = 0; x < dwidth; x++)
+		{
+			UINT32 curx = x * dx + dx / 2 - 0x800;
+			UINT32 pix[4];
+
+			/* fetch the four relevant pixels */
+			resample_bilinear_fetch(row0, row1, curx, maxx, pix);
+
+			/* interleave left/right pixels as 16-bit pairs and apply the X weights */
+			curx &= 0xfff;
+			__m128i xweight = _mm_set1_epi32((curx << 16) | (0x1000 - curx));
+			__m128i top = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pix[0]), zero), _mm_unpacklo_epi8(_mm_cvtsi32_si128(pix[1]), zero));
+			__m128i bottom = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pix[2]), zero), _mm_unpacklo_epi8(_mm_cvtsi32_si128(pix[3]), zero));
+			top = _mm_madd_epi16(top, xweight);
+			bottom = _mm_madd_epi16(bottom, xweight);
+
+			/* apply the Y weights; SSE2 only has even-lane 32x32 multiplies, so do odd lanes separately */
+			__m128i even = _mm_add_epi64(_mm_mul_epu32(top, yweight0), _mm_mul_epu32(bottom, yweight1));
+			__m128i odd = _mm_add_epi64(_mm_mul_epu32(_mm_srli_si128(top, 4), yweight0), _mm_mul_epu32(_mm_srli_si128(bottom, 4), yweight1));
+			__m128i sum = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+
+			/* apply scaling and store the target pixel */
+			sum = _mm_packs_epi32(_mm_srli_epi32(sum, 24), zero);
+			sum = _mm_srli_epi16(_mm_mullo_epi16(sum, scale), 8);
+			d[x] = _mm_cvtsi128_si32(_mm_packus_epi16(sum, zero));
+		}
+	}
+}
+
+#endif
+
+
+#ifdef RENDSAMP_AVX2
+
+/*-------------------------------------------------
+    resample_have_avx2 - return true if the CPU
+    and OS support AVX2
+-------------------------------------------------*/
+
+INLINE bool resample_have_avx2(void)
+{
+	// racing threads all compute the same answer
+	static int s_have_avx2 = -1;
+	if (s_have_avx2 == -1)
+	{
+		UINT32 ecx1, ebx7, xcr0 = 0;
+#ifdef _MSC_VER
+		int regs1[4], regs7[4];
+		__cpuid(regs1, 0);
+		bool leaf7 = (regs1[0] >= 7);
+		__cpuid(regs1, 1);
+		__cpuidex(regs7, 7, 0);
+		ecx1 = regs1[2];
+		ebx7 = leaf7 ? regs7[1] : 0;
+		if ((ecx1 >> 27) & 1)
+			xcr0 = (UINT32)_xgetbv(0);
+#else
+		unsigned int eax, ebx, ecx, edx;
+		ecx1 = __get_cpuid(1, &eax, &ebx, &ecx, &edx) ? ecx : 0;
+		ebx7 = 0;
+		if (__get_cpuid_max(0, NULL) >= 7)
+		{
+			__cpuid_count(7, 0, eax, ebx, ecx, edx);
+			ebx7 = ebx;
+		}
+		if ((ecx1 >> 27) & 1)
+		{
+			__asm__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+			xcr0 = eax;
+		}
+#endif
+		// AVX2, plus OSXSAVE with the OS saving the XMM and YMM state
+		s_have_avx2 = ((ebx7 >> 5) & 1) && ((ecx1 >> 27) & 1) && ((xcr0 & 6) == 6);
+	}
+	return (s_have_avx2 != 0);
+}
+
+
+/*-------------------------------------------------
+    resample_argb_bitmap_bilinear_avx2 - AVX2
+    version of the SSE2 filter, doing two target
+    pixels at once, one per 128-bit lane; AVX2
+    has a full 32x32 multiply, and the weighted
+    sums never exceed 0xff000000, so it gives
+    the same sums as the scalar code
+-------------------------------------------------*/
+
+INLINE AVX2_TARGET void resample_argb_bitmap_bilinear_avx2(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy)
+{
+	UINT32 maxx = swidth << 12, maxy = sheight << 12;
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i scale = _mm256_set_epi16(a, r, g, b, a, r, g, b, a, r, g, b, a, r, g, b);
+	UINT32 x, y;
+
+	/* loop over the target vertically */
+	for (y = 0; y < dheight; y++)
+	{
+		UINT32 cury = y * dy + dy / 2 - 0x800;
+		UINT32 nexty = cury + 0x1000;
+		UINT32 *d = &dest[y * drowpixels];
+
+		/* determine the two source rows, or NULL if they are out of range */
+		const UINT32 *row0 = ((INT32)cury >= 0 && cury < maxy) ? &source[(cury >> 12) * srowpixels] : NULL;
+		const UINT32 *row1 = ((INT32)nexty >= 0 && nexty < maxy) ? &source[(nexty >> 12) * srowpixels] : NULL;
+
+		/* the Y weights are constant across the row */
+		const __m256i yweight0 = _mm256_set1_epi32(0x1000 - (cury & 0xfff));
+		const __m256i yweight1 = _mm256_set1_epi32(cury & 0xfff);
+
+		/* loop over the target horizontally; an odd last pixel computes a second one it doesn't store */
+		for (x = 0; x < dwidth; x += 2)
+		{
+			UINT32 curx0 = x * dx + dx / 2 - 0x800;
+			UINT32 curx1 = curx0 + dx;
+			UINT32 pix0[4], pix1[4];
+
+			/* fetch the four relevant pixels for each target pixel */
+			resample_bilinear_fetch(row0, row1, curx0, maxx, pix0);
+			resample_bilinear_fetch(row0, row1, curx1, maxx, pix1);
+
+			/* interleave left/right bytes, one target pixel per lane, widen and apply the X weights */
+			curx0 &= 0xfff;
+			curx1 &= 0xfff;
+			UINT32 xweight0 = (curx0 << 16) | (0x1000 - curx0);
+			UINT32 xweight1 = (curx1 << 16) | (0x1000 - curx1);
+			__m256i xweight = _mm256_set_epi32(xweight1, xweight1, xweight1, xweight1, xweight0, xweight0, xweight0, xweight0);
+			__m128i top = _mm_unpacklo_epi64(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pix0[0]), _mm_cvtsi32_si128(pix0[1])), _mm_unpacklo_epi8(_mm_cvtsi32_si128(pix1[0]), _mm_cvtsi32_si128(pix1[1])));
+			__m128i bottom = _mm_unpacklo_epi64(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pix0[2]), _mm_cvtsi32_si128(pix0[3])), _mm_unpacklo_epi8(_mm_cvtsi32_si128(pix1[2]), _mm_cvtsi32_si128(pix1[3])));
+			__m256i topsum = _mm256_madd_epi16(_mm256_cvtepu8_epi16(top), xweight);
+			__m256i bottomsum = _mm256_madd_epi16(_mm256_cvtepu8_epi16(bottom), xweight);
+
+			/* apply the Y weights */
+			__m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(topsum, yweight0), _mm256_mullo_epi32(bottomsum, yweight1));
+
+			/* apply scaling and store the target pixels */
+			sum = _mm256_packs_epi32(_mm256_srli_epi32(sum, 24), zero);
+			sum = _mm256_srli_epi16(_mm256_mullo_epi16(sum, scale), 8);
+			sum = _mm256_packus_epi16(sum, zero);
+			d[x] = _mm_cvtsi128_si32(_mm256_castsi256_si128(sum));
+			if (x + 1 < dwidth)
+				d[x + 1] = _mm_cvtsi128_si32(_mm256_extracti128_si256(sum, 1));
+		}
+	}
+}
+
+#endif
+
+#endif  /* __RENDSAMP_H__ */
@@ -12,6 +12,7 @@
 #include "emu.h"
 #include "render.h"
 #include "rendutil.h"
+#include "rendsamp.h"
 #include "png.h"
 
 
@@ -155,14 +156,14 @@ static void resample_argb_bitmap_average(UINT32 *dest, UINT32 drowpixels, UINT32
 
 /*-------------------------------------------------
     resample_argb_bitmap_bilinear - perform texture
-    sampling via a bilinear filter
+    sampling via a bilinear filter, using the
+    widest kernel from rendsamp.h that the CPU
+    and color allow
 -------------------------------------------------*/
 
 static void resample_argb_bitmap_bilinear(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, const render_color &color, UINT32 dx, UINT32 dy)
 {
-	UINT32 maxx = swidth << 12, maxy = sheight << 12;
 	UINT32 r, g, b, a;
-	UINT32 x, y;
 
 	/* precompute premultiplied R/G/B/A factors */
 	r = color.r * color.a * 256.0;
@@ -170,93 +171,23 @@ static void resample_argb_bitmap_bilinear(UINT32 *dest, UINT32 drowpixels, UINT3
 	b = color.b * color.a * 256.0;
 	a = color.a * 256.0;
 
-	/* loop over the target vertically */
-	for (y = 0; y < dheight; y++)
+#ifdef RENDSAMP_SSE2
+	/* the opaque case is handled 4 channels at a time; the results are bit-identical */
+	if (a == 256 && r <= 256 && g <= 256 && b <= 256)
 	{
-		UINT32 starty = y * dy;
-
-		/* loop over the target horizontally */
-		for (x = 0; x < dwidth; x++)
+#ifdef RENDSAMP_AVX2
+		if (resample_have_avx2())
 		{
-			UINT32 startx = x * dx;
-			rgb_t pix0, pix1, pix2, pix3;
-			UINT32 sumr, sumg, sumb, suma;
-			UINT32 nextx, nexty;
-			UINT32 curx, cury;
-			UINT32 factor;
-
-			/* adjust start to the center; note that this math will tend to produce */
-			/* negative results on the first pixel, which is why we clamp below */
-			curx = startx + dx / 2 - 0x800;
-			cury = starty + dy / 2 - 0x800;
-
-			/* compute the neighboring pixel */
-			nextx = curx + 0x1000;
-			nexty = cury + 0x1000;
-
-			/* fetch the four relevant pixels */
-			pix0 = pix1 = pix2 = pix3 = 0;
-			if ((INT32)cury >= 0 && cury < maxy && (INT32)curx >= 0 && curx < maxx)
-				pix0 = source[(cury >> 12) * srowpixels + (curx >> 12)];
-			if ((INT32)cury >= 0 && cury < maxy && (INT32)nextx >= 0 && nextx < maxx)
-				pix1 = source[(cury >> 12) * srowpixels + (nextx >> 12)];
-			if ((INT32)nexty >= 0 && nexty < maxy && (INT32)curx >= 0 && curx < maxx)
-				pix2 = source[(nexty >> 12) * srowpixels + (curx >> 12)];
-			if ((INT32)nexty >= 0 && nexty < maxy && (INT32)nextx >= 0 && nextx < maxx)
-				pix3 = source[(nexty >> 12) * srowpixels + (nextx >> 12)];
-
-			/* compute the x/y scaling factors */
-			curx &= 0xfff;
-			cury &= 0xfff;
-
-			/* contributions from pixel 0 (top,left) */
-			factor = (0x1000 - curx) * (0x1000 - cury);
-			sumr = factor * pix0.r();
-			sumg = factor * pix0.g();
-			sumb = factor * pix0.b();
-			suma = factor * pix0.a();
-
-			/* contributions from pixel 1 (top,right) */
-			factor = curx * (0x1000 - cury);
-			sumr += factor * pix1.r();
-			sumg += factor * pix1.g();
-			sumb += factor * pix1.b();
-			suma += factor * pix1.a();
-
-			/* contributions from pixel 2 (bottom,left) */
-			factor = (0x1000 - curx) * cury;
-			sumr += factor * pix2.r();
-			sumg += factor * pix2.g();
-			sumb += factor * pix2.b();
-			suma += factor * pix2.a();
-
-			/* contributions from pixel 3 (bottom,right) */
-			factor = curx * cury;
-			sumr += factor * pix3.r();
-			sumg += factor * pix3.g();
-			sumb += factor * pix3.b();
-			suma += factor * pix3.a();
-
-			/* apply scaling */
-			suma = (suma >> 24) * a / 256;
-			sumr = (sumr >> 24) * r / 256;
-			sumg = (sumg >> 24) * g / 256;
-			sumb = (sumb >> 24) * b / 256;
-
-			/* if we're translucent, add in the destination pixel contribution */
-			if (a < 256)
-			{
-				rgb_t dpix = dest[y * drowpixels + x];
-				suma += dpix.a() * (256 - a);
-				sumr += dpix.r() * (256 - a);
-				sumg += dpix.g() * (256 - a);
-				sumb += dpix.b() * (256 - a);
-			}
-
-			/* store the target pixel, dividing the RGBA values by the overall scale factor */
-			dest[y * drowpixels + x] = rgb_t(suma, sumr, sumg, sumb);
+			resample_argb_bitmap_bilinear_avx2(dest, drowpixels, dwidth, dheight, source, srowpixels, swidth, sheight, r, g, b, a, dx, dy);
+			return;
 		}
+#endif
+		resample_argb_bitmap_bilinear_sse2(dest, drowpixels, dwidth, dheight, source, srowpixels, swidth, sheight, r, g, b, a, dx, dy);
+		return;
 	}
+#endif
+
+	resample_argb_bitmap_bilinear_c(dest, drowpixels, dwidth, dheight, source, srowpixels, swidth, sheight, r, g, b, a, dx, dy);
 }
 
 
@@ -28,6 +28,9 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+/* how many ROMs of a region to open and unpack ahead of the one being read */
+#define ROM_PREFETCH_DEPTH      8
+
 
 
 /***************************************************************************
@@ -57,6 +60,70 @@ private:
 };
 
 
+class pending_verify
+{
+	friend class simple_list<pending_verify>;
+
+public:
+	pending_verify(emu_file *file, const char *name, UINT32 explength, const hash_collection &hashes)
+		: m_next(NULL),
+			m_file(file),
+			m_name(name),
+			m_explength(explength),
+			m_actlength(0),
+			m_hashes(hashes),
+			m_data(NULL) { }
+	~pending_verify() { global_free(m_file); }
+
+	pending_verify *next() const { return m_next; }
+
+	pending_verify *    m_next;                 /* pointer to next in the list */
+	emu_file *          m_file;                 /* the file, closed once verified */
+	astring             m_name;                 /* ROM name for messages */
+	UINT32              m_explength;            /* expected length */
+	UINT32              m_actlength;            /* actual length */
+	hash_collection     m_hashes;               /* expected hashes */
+	hash_collection     m_acthashes;            /* actual hashes, completed by the worker */
+	astring             m_needed;               /* hash types the worker must compute */
+	const UINT8 *       m_data;                 /* file contents to hash */
+};
+
+
+class prefetched_rom
+{
+	friend class simple_list<prefetched_rom>;
+
+public:
+	prefetched_rom(const rom_entry *romp)
+		: m_next(NULL),
+			m_romp(romp),
+			m_file(NULL),
+			m_found(false),
+			m_item(NULL) { }
+	~prefetched_rom() { wait(); global_free(m_file); }
+
+	prefetched_rom *next() const { return m_next; }
+
+	/* wait for any unpacking still in flight */
+	void wait()
+	{
+		if (m_item != NULL)
+		{
+			osd_work_item_wait(m_item, osd_ticks_per_second() * 100);
+			osd_work_item_release(m_item);
+			m_item = NULL;
+		}
+	}
+
+	prefetched_rom *    m_next;                 /* pointer to next in the list */
+	const rom_entry *   m_romp;                 /* ROM entry the file was opened for */
+	emu_file *          m_file;                 /* the file, or NULL if not opened */
+	bool                m_found;                /* result of open_rom_file */
+	astring             m_tried_file_names;     /* where we looked, for messages */
+	osd_work_item *     m_item;                 /* unpacking work, if queued */
+};
+
+
 struct romload_private
 {
 	running_machine &machine() const { assert(m_machine != NULL); return *m_machine; }
@@ -75,6 +142,10 @@ struct romload_private
 	emu_file *      file;               /* current file */
 	simple_list<open_chd> chd_list;     /* disks */
 
+	osd_work_queue *verify_queue;       /* queue for hashing ROMs in the background */
+	osd_work_queue *prefetch_queue;     /* queue for unpacking upcoming ROMs */
+	simple_list<pending_verify> verify_list; /* verifications not yet reported */
+
 	memory_region * region;             /* info about current region */
 
 	astring         errorstring;        /* error string */
@@ -87,6 +158,7 @@ struct romload_private
 ***************************************************************************/
 
 static void rom_exit(running_machine &machine);
+static void flush_pending_verifies(romload_private *romdata);
 
 /***************************************************************************
     HELPERS (also used by devimage.c)
@@ -106,7 +178,8 @@ file_error common_process_file(emu_options &options, const char *location, const
 
 file_error common_process_file(emu_options &options, const char *location, bool has_crc, UINT32 crc, const rom_entry *romp, emu_file **image_file)
 {
-	*image_file = global_alloc(emu_file(options.media_path(), OPEN_FLAG_READ));
+	// leave archive members packed until they are read, so stored ZIP members can be mapped instead
+	*image_file = global_alloc(emu_file(options.media_path(), OPEN_FLAG_READ | OPEN_FLAG_NO_PRELOAD));
 	file_error filerr;
 
 	if (has_crc)
@@ -376,6 +449,9 @@ static void fill_random(running_machine &machine, UINT8 *base, UINT32 length)
 
 static void handle_missing_file(romload_private *romdata, const rom_entry *romp, astring tried_file_names, chd_error chderr)
 {
+	/* report earlier ROMs first so messages stay in order */
+	flush_pending_verifies(romdata);
+
 	if(tried_file_names.len() != 0)
 		tried_file_names = " (tried in " + tried_file_names + ")";
 
@@ -430,46 +506,122 @@ static void dump_wrong_and_correct_checksums(romload_private *romdata, const has
 
 
 /*-------------------------------------------------
-    verify_length_and_hash - verify the length
-    and hash signatures of a file
+    verify_hash_callback - compute the missing
+    hashes of a pending verification on a worker
 -------------------------------------------------*/
 
-static void verify_length_and_hash(romload_private *romdata, const char *name, UINT32 explength, const hash_collection &hashes)
+static void *verify_hash_callback(void *param, int threadid)
+{
+	pending_verify &verify = *(pending_verify *)param;
+	if (verify.m_data != NULL)
+		verify.m_acthashes.compute(verify.m_data, verify.m_actlength, verify.m_needed);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    verify_length_and_hash - queue verification of
+    the length and hash signatures of a file; the
+    pending verification takes ownership of the
+    file, and the hashing runs on a work queue
+-------------------------------------------------*/
+
+static void verify_length_and_hash(romload_private *romdata, const char *name, UINT32 explength, const hash_collection &hashes, const UINT8 *mapped)
 {
 	/* we've already complained if there is no file */
 	if (romdata->file == NULL)
 		return;
 
-	/* verify length */
-	UINT32 actlength = romdata->file->size();
-	if (explength != actlength)
-	{
-		romdata->errorstring.catprintf("%s WRONG LENGTH (expected: %08x found: %08x)\n", name, explength, actlength);
-		romdata->warnings++;
-	}
+	pending_verify &verify = romdata->verify_list.append(*global_alloc(pending_verify(romdata->file, name, explength, hashes)));
+	verify.m_actlength = romdata->file->size();
+
+	/* start from whatever hashes the file already knows (a ZIP's CRC, or the hash cache) */
+	astring types, already_have;
+	hashes.hash_types(types);
+	verify.m_acthashes = romdata->file->cached_hashes(types);
+	verify.m_acthashes.hash_types(already_have);
+	for (const char *scan = types; *scan != 0; scan++)
+		if (already_have.chr(0, *scan) == -1)
+			verify.m_needed.cat(*scan);
+	if (!verify.m_needed)
+		return;
 
-	/* If there is no good dump known, write it */
-	astring tempstr;
-	hash_collection &acthashes = romdata->file->hashes(hashes.hash_types(tempstr));
-	if (hashes.flag(hash_collection::FLAG_NO_DUMP))
-	{
-		romdata->errorstring.catprintf("%s NO GOOD DUMP KNOWN\n", name);
-		romdata->knownbad++;
-	}
-	/* verify checksums */
-	else if (hashes != acthashes)
+	/* hash a mapped region in place; otherwise load the whole file here, since
+	   that touches the file system, and hash it elsewhere */
+	if (mapped != NULL)
+		verify.m_data = mapped;
+	else
 	{
-		/* otherwise, it's just bad */
-		romdata->errorstring.catprintf("%s WRONG CHECKSUMS:\n", name);
-		dump_wrong_and_correct_checksums(romdata, hashes, acthashes);
-		romdata->warnings++;
+		core_file *corefile = *romdata->file;
+		if (corefile != NULL)
+			verify.m_data = (const UINT8 *)core_fbuffer(corefile);
 	}
-	/* If it matches, but it is actually a bad dump, write it */
-	else if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
+	if (verify.m_data == NULL)
+		return;
+
+	if (romdata->verify_queue == NULL)
+		romdata->verify_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	if (romdata->verify_queue != NULL)
+		osd_work_item_queue(romdata->verify_queue, verify_hash_callback, &verify, WORK_ITEM_FLAG_AUTO_RELEASE);
+	else
+		verify_hash_callback(&verify, 0);
+}
+
+
+/*-------------------------------------------------
+    flush_pending_verifies - wait for outstanding
+    hashing, then report each verification in the
+    order the ROMs were loaded and close the files
+-------------------------------------------------*/
+
+static void flush_pending_verifies(romload_private *romdata)
+{
+	if (romdata->verify_list.count() == 0)
+		return;
+	if (romdata->verify_queue != NULL)
+		osd_work_queue_wait(romdata->verify_queue, osd_ticks_per_second() * 100);
+
+	for (pending_verify *verify = romdata->verify_list.first(); verify != NULL; verify = verify->next())
 	{
-		romdata->errorstring.catprintf("%s ROM NEEDS REDUMP\n",name);
-		romdata->knownbad++;
+		/* remember anything we had to compute */
+		if (verify->m_needed && verify->m_data != NULL)
+			verify->m_file->cache_hashes(verify->m_acthashes);
+
+		const char *name = verify->m_name;
+		const hash_collection &hashes = verify->m_hashes;
+		const hash_collection &acthashes = verify->m_acthashes;
+
+		/* verify length */
+		if (verify->m_explength != verify->m_actlength)
+		{
+			romdata->errorstring.catprintf("%s WRONG LENGTH (expected: %08x found: %08x)\n", name, verify->m_explength, verify->m_actlength);
+			romdata->warnings++;
+		}
+
+		/* If there is no good dump known, write it */
+		if (hashes.flag(hash_collection::FLAG_NO_DUMP))
+		{
+			romdata->errorstring.catprintf("%s NO GOOD DUMP KNOWN\n", name);
+			romdata->knownbad++;
+		}
+		/* verify checksums */
+		else if (hashes != acthashes)
+		{
+			/* otherwise, it's just bad */
+			romdata->errorstring.catprintf("%s WRONG CHECKSUMS:\n", name);
+			dump_wrong_and_correct_checksums(romdata, hashes, acthashes);
+			romdata->warnings++;
+		}
+		/* If it matches, but it is actually a bad dump, write it */
+		else if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
+		{
+			romdata->errorstring.catprintf("%s ROM NEEDS REDUMP\n",name);
+			romdata->knownbad++;
+		}
 	}
+
+	/* free the records, closing the files */
+	romdata->verify_list.reset();
 }
 
 
@@ -681,6 +833,58 @@ static int open_rom_file(romload_private *romdata, const char *regiontag, const
 }
 
 
+/*-------------------------------------------------
+    prefetch_rom_callback - unpack a prefetched
+    ROM on a worker
+-------------------------------------------------*/
+
+static void *prefetch_rom_callback(void *param, int threadid)
+{
+	emu_file *file = (emu_file *)param;
+	file->preload_zipped();
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    prefetch_rom_files - open a region's ROMs in
+    order, up to ROM_PREFETCH_DEPTH ahead of the
+    one being read, and unpack them on a work
+    queue in the meantime
+-------------------------------------------------*/
+
+static void prefetch_rom_files(romload_private *romdata, const char *regiontag, device_t *device, bool from_list, simple_list<prefetched_rom> &prefetched, const rom_entry *&nextromp)
+{
+	for ( ; prefetched.count() < ROM_PREFETCH_DEPTH && !ROMENTRY_ISREGIONEND(nextromp); nextromp++)
+	{
+		if (!ROMENTRY_ISFILE(nextromp))
+			continue;
+		prefetched_rom &rom = prefetched.append(*global_alloc(prefetched_rom(nextromp)));
+
+		/* open the file if it is a non-BIOS or matches the current BIOS */
+		if (ROM_GETBIOSFLAGS(nextromp) != 0 && ROM_GETBIOSFLAGS(nextromp) != device->system_bios())
+			continue;
+		LOG(("Opening ROM file: %s\n", ROM_GETNAME(nextromp)));
+		rom.m_found = open_rom_file(romdata, regiontag, nextromp, rom.m_tried_file_names, from_list);
+		rom.m_file = romdata->file;
+		romdata->file = NULL;
+		if (rom.m_file == NULL)
+			continue;
+
+		/* 7z members reuse the archive's decoded solid block only if unpacked in order */
+		rom.m_file->preload_7zped();
+
+		/* the region's last ROM may be mapped, which needs it left packed */
+		if (ROMENTRY_ISREGIONEND(nextromp + 1))
+			continue;
+		if (romdata->prefetch_queue == NULL)
+			romdata->prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (romdata->prefetch_queue != NULL)
+			rom.m_item = osd_work_item_queue(romdata->prefetch_queue, prefetch_rom_callback, rom.m_file, 0);
+	}
+}
+
+
 /*-------------------------------------------------
     rom_fread - cheesy fread that fills with
     random data for a NULL file
@@ -816,6 +1020,45 @@ static int read_rom_data(romload_private *romdata, const rom_entry *parent_regio
 }
 
 
+/*-------------------------------------------------
+    map_rom_data - back the whole region with a
+    copy-on-write mapping of the ROM file rather
+    than reading a copy, when a single plain load
+    fills the region and nothing post-processes it
+-------------------------------------------------*/
+
+static bool map_rom_data(romload_private *romdata, const rom_entry *parent_region, const rom_entry *romp)
+{
+	/* the ROM must be the region's only entry and cover it exactly */
+	if (romdata->file == NULL || !ROMENTRY_ISREGIONEND(romp + 1) || ROM_INHERITSFLAGS(romp))
+		return false;
+	if (ROM_GETOFFSET(romp) != 0 || ROM_GETLENGTH(romp) != romdata->region->bytes() || romdata->file->size() != ROM_GETLENGTH(romp))
+		return false;
+
+	/* only a straight byte-for-byte load */
+	if (ROM_GETBITWIDTH(romp) != 8 || ROM_GETBITSHIFT(romp) != 0 || ROM_GETSKIPCOUNT(romp) != 0 || (ROM_GETGROUPSIZE(romp) != 1 && ROM_ISREVERSED(romp)))
+		return false;
+
+	/* inverted or byte-swapped regions get a private copy */
+	if (ROMREGION_ISINVERTED(parent_region) || (romdata->region->bytewidth() > 1 && romdata->region->endianness() != ENDIANNESS_NATIVE))
+		return false;
+
+	void *base;
+	if (romdata->file->map(&base) != FILERR_NONE)
+		return false;
+
+	/* stored ZIP members can sit at any offset; keep the region's native accesses aligned */
+	if (((FPTR)base & (romdata->region->bytewidth() - 1)) != 0)
+	{
+		osd_unmap(base, ROM_GETLENGTH(romp));
+		return false;
+	}
+	LOG(("Mapped ROM data: len=%X\n", ROM_GETLENGTH(romp)));
+	romdata->region->set_mapping(base);
+	return true;
+}
+
+
 /*-------------------------------------------------
     fill_rom_data - fill a region of ROM space
 -------------------------------------------------*/
@@ -879,6 +1122,8 @@ static void copy_rom_data(romload_private *romdata, const rom_entry *romp)
 static void process_rom_entries(romload_private *romdata, const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, device_t *device, bool from_list)
 {
 	UINT32 lastflags = 0;
+	simple_list<prefetched_rom> prefetched;
+	const rom_entry *nextromp = romp;
 
 	/* loop until we hit the end of this region */
 	while (!ROMENTRY_ISREGIONEND(romp))
@@ -910,11 +1155,19 @@ static void process_rom_entries(romload_private *romdata, const char *regiontag,
 			const rom_entry *baserom = romp;
 			int explength = 0;
 
-			/* open the file if it is a non-BIOS or matches the current BIOS */
-			LOG(("Opening ROM file: %s\n", ROM_GETNAME(romp)));
-			astring tried_file_names;
-			if (!irrelevantbios && !open_rom_file(romdata, regiontag, romp, tried_file_names, from_list))
-				handle_missing_file(romdata, romp, tried_file_names, CHDERR_NONE);
+			/* take the file from the lookahead, which opens the ROMs that follow */
+			prefetch_rom_files(romdata, regiontag, device, from_list, prefetched, nextromp);
+			prefetched_rom *rom = prefetched.detach_head();
+			assert(rom != NULL && rom->m_romp == romp);
+			rom->wait();
+			romdata->file = rom->m_file;
+			rom->m_file = NULL;
+			if (!irrelevantbios && !rom->m_found)
+				handle_missing_file(romdata, romp, rom->m_tried_file_names, CHDERR_NONE);
+			global_free(rom);
+
+			/* map the file in place of reading it if we can */
+			bool mapped = (!irrelevantbios && map_rom_data(romdata, parent_region, romp));
 
 			/* loop until we run out of reloads */
 			do
@@ -934,7 +1187,7 @@ static void process_rom_entries(romload_private *romdata, const char *regiontag,
 					explength += ROM_GETLENGTH(&modified_romp);
 
 					/* attempt to read using the modified entry */
-					if (!ROMENTRY_ISIGNORE(&modified_romp) && !irrelevantbios)
+					if (!ROMENTRY_ISIGNORE(&modified_romp) && !irrelevantbios && !mapped)
 						/*readresult = */read_rom_data(romdata, parent_region, &modified_romp);
 				}
 				while (ROMENTRY_ISCONTINUE(romp) || ROMENTRY_ISIGNORE(romp));
@@ -943,23 +1196,23 @@ static void process_rom_entries(romload_private *romdata, const char *regiontag,
 				if (baserom)
 				{
 					LOG(("Verifying length (%X) and checksums\n", explength));
-					verify_length_and_hash(romdata, ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)));
+					verify_length_and_hash(romdata, ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)), mapped ? romdata->region->base() : NULL);
 					LOG(("Verify finished\n"));
 				}
 
-				/* reseek to the start and clear the baserom so we don't reverify */
-				if (romdata->file != NULL)
+				/* reseek to the start and clear the baserom so we don't reverify; a mapped
+				   file has no reloads, and seeking would unpack a mapped ZIP member */
+				if (romdata->file != NULL && !mapped)
 					romdata->file->seek(0, SEEK_SET);
 				baserom = NULL;
 				explength = 0;
 			}
 			while (ROMENTRY_ISRELOAD(romp));
 
-			/* close the file */
+			/* hand the file off; its pending verification closes it */
 			if (romdata->file != NULL)
 			{
 				LOG(("Closing ROM file\n"));
-				global_free(romdata->file);
 				romdata->file = NULL;
 			}
 		}
@@ -1170,6 +1423,9 @@ static chd_error open_disk_diff(emu_options &options, const rom_entry *romp, chd
 
 static void process_disk_entries(romload_private *romdata, const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, const char *locationtag)
 {
+	/* report any outstanding ROM verifications first */
+	flush_pending_verifies(romdata);
+
 	/* loop until we hit the end of this region */
 	for ( ; !ROMENTRY_ISREGIONEND(romp); romp++)
 	{
@@ -1380,6 +1636,7 @@ void load_software_part_region(device_t &device, software_list_device &swlist, c
 		else if (ROMREGION_ISDISKDATA(region))
 			process_disk_entries(romdata, regiontag, region, region + 1, locationtag);
 	}
+	flush_pending_verifies(romdata);
 
 	/* now go back and post-process all the regions */
 	for (region = start_region; region != NULL; region = rom_next_region(region))
@@ -1446,6 +1703,7 @@ static void process_region_list(romload_private *romdata)
 			else if (ROMREGION_ISDISKDATA(region))
 				process_disk_entries(romdata, regiontag, region, region + 1, NULL);
 		}
+	flush_pending_verifies(romdata);
 
 	/* now go back and post-process all the regions */
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
@@ -1513,6 +1771,14 @@ void rom_init(running_machine &machine)
 
 static void rom_exit(running_machine &machine)
 {
+	romload_private *romdata = machine.romload_data;
+	flush_pending_verifies(romdata);
+	if (romdata->verify_queue != NULL)
+		osd_work_queue_free(romdata->verify_queue);
+	romdata->verify_queue = NULL;
+	if (romdata->prefetch_queue != NULL)
+		osd_work_queue_free(romdata->prefetch_queue);
+	romdata->prefetch_queue = NULL;
 }
 
 
@@ -61,7 +61,10 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 		m_visarea(0, 99, 0, 99),
 		m_curbitmap(0),
 		m_curtexture(0),
+		m_numbitmaps(2),
 		m_changed(true),
+		m_dirty_region(0, -1, 0, -1),
+		m_dirty_palette_serial(0),
 		m_last_partial_scan(0),
 		m_frame_period(DEFAULT_FRAME_PERIOD.as_attoseconds()),
 		m_scantime(1),
@@ -74,7 +77,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 		m_scanline0_timer(NULL),
 		m_scanline_timer(NULL),
 		m_frame_number(0),
-		m_partial_updates_this_frame(0)
+		m_partial_updates_this_frame(0),
+		m_partial_updates_last_frame(0)
 {
 	m_unique_id = m_id_counter;
 	m_id_counter++;
@@ -285,21 +289,25 @@ void screen_device::device_start()
 	if (m_palette != NULL && !m_palette->started())
 		throw device_missing_dependencies();
 
-	// configure bitmap formats and allocate screen bitmaps
+	// configure bitmap formats and allocate screen bitmaps; when the video pipeline
+	// is enabled, a third bitmap keeps the frame being presented by the OSD from
+	// being overwritten while the next one is emulated
 	texture_format texformat = !m_screen_update_ind16.isnull() ? TEXFORMAT_PALETTE16 : TEXFORMAT_RGB32;
-
-	for (int index = 0; index < ARRAY_LENGTH(m_bitmap); index++)
+	m_numbitmaps = machine().options().video_pipeline() ? 3 : 2;
+	for (int index = 0; index < m_numbitmaps; index++)
 	{
 		m_bitmap[index].set_format(format(), texformat);
 		register_screen_bitmap(m_bitmap[index]);
 	}
 	register_screen_bitmap(m_priority);
 
-	// allocate raw textures
-	m_texture[0] = machine().render().texture_alloc();
-	m_texture[0]->set_osd_data((UINT64)((m_unique_id << 1) | 0));
-	m_texture[1] = machine().render().texture_alloc();
-	m_texture[1]->set_osd_data((UINT64)((m_unique_id << 1) | 1));
+	// allocate raw textures; the OSD data holds the screen id above a two-bit
+	// page index, so every bitmap of the pipeline gets its own render target
+	for (int index = 0; index < m_numbitmaps; index++)
+	{
+		m_texture[index] = machine().render().texture_alloc();
+		m_texture[index]->set_osd_data((UINT64)((m_unique_id << 2) | index));
+	}
 
 	// configure the default cliparea
 	render_container::user_settings settings;
@@ -324,6 +332,9 @@ void screen_device::device_start()
 	// configure the screen with the default parameters
 	configure(m_width, m_height, m_visarea, m_refresh);
 
+	// nothing has been drawn yet, so the first frame must be
+	mark_all_dirty();
+
 	// reset VBLANK timing
 	m_vblank_start_time = attotime::zero;
 	m_vblank_end_time = attotime(0, m_vblank_period);
@@ -372,8 +383,8 @@ void screen_device::device_start()
 
 void screen_device::device_stop()
 {
-	machine().render().texture_free(m_texture[0]);
-	machine().render().texture_free(m_texture[1]);
+	for (int index = 0; index < m_numbitmaps; index++)
+		machine().render().texture_free(m_texture[index]);
 	if (m_burnin.valid())
 		finalize_burnin();
 }
@@ -387,6 +398,7 @@ void screen_device::device_stop()
 void screen_device::device_post_load()
 {
 	realloc_screen_bitmaps();
+	raster_frame_start();
 }
 
 
@@ -411,6 +423,7 @@ void screen_device::device_timer(emu_timer &timer, device_timer_id id, int param
 
 		// first scanline
 		case TID_SCANLINE0:
+			raster_frame_start();
 			reset_partial_updates();
 			break;
 
@@ -481,7 +494,10 @@ void screen_device::configure(int width, int height, const rectangle &visarea, a
 	// if we are on scanline 0 already, call the scanline 0 timer
 	// by hand now; otherwise, adjust it for the future
 	if (vpos() == 0)
+	{
+		raster_frame_start();
 		reset_partial_updates();
+	}
 	else
 		m_scanline0_timer->adjust(time_until_pos(0));
 
@@ -505,7 +521,10 @@ void screen_device::reset_origin(int beamy, int beamx)
 	// if we are resetting relative to (0,0) == VBLANK end, call the
 	// scanline 0 timer by hand now; otherwise, adjust it for the future
 	if (beamy == 0 && beamx == 0)
+	{
+		raster_frame_start();
 		reset_partial_updates();
+	}
 	else
 		m_scanline0_timer->adjust(time_until_pos(0));
 
@@ -540,11 +559,14 @@ void screen_device::realloc_screen_bitmaps()
 	// re-set up textures
 	if (m_palette != NULL)
 	{
-		m_bitmap[0].set_palette(m_palette->palette());
-		m_bitmap[1].set_palette(m_palette->palette());
+		for (int index = 0; index < m_numbitmaps; index++)
+			m_bitmap[index].set_palette(m_palette->palette());
 	}
-	m_texture[0]->set_bitmap(m_bitmap[0], m_visarea, m_bitmap[0].texformat());
-	m_texture[1]->set_bitmap(m_bitmap[1], m_visarea, m_bitmap[1].texformat());
+	for (int index = 0; index < m_numbitmaps; index++)
+		m_texture[index]->set_bitmap(m_bitmap[index], m_visarea, m_bitmap[index].texformat());
+
+	// the bitmaps no longer match what was drawn before
+	mark_all_dirty();
 }
 
 
@@ -631,12 +653,62 @@ bool screen_device::update_partial(int scanline)
 	// if we modified the bitmap, we have to commit
 	m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
 
+	// once the bottom of the visible area is rendered, the dirty region is consumed
+	if (clip.max_y == m_visarea.max_y)
+	{
+		m_dirty_region.set(0, -1, 0, -1);
+		if (m_palette != NULL)
+			m_dirty_palette_serial = m_palette->palette()->serial();
+	}
+
 	// remember where we left off
 	m_last_partial_scan = scanline + 1;
 	return true;
 }
 
 
+//-------------------------------------------------
+//  mark_dirty - add a rectangle, in screen
+//  coordinates, to the area that must be redrawn
+//-------------------------------------------------
+
+void screen_device::mark_dirty(const rectangle &rect)
+{
+	rectangle clipped = rect;
+	clipped &= m_visarea;
+	if (clipped.empty())
+		return;
+	if (m_dirty_region.empty())
+		m_dirty_region = clipped;
+	else
+		m_dirty_region |= clipped;
+}
+
+
+//-------------------------------------------------
+//  update_needed - return false if a screen update
+//  callback may skip drawing cliprect and return
+//  UPDATE_HAS_NOT_CHANGED; drivers merge tilemap
+//  and sprite regions via mark_dirty beforehand.
+//  Because the screen bitmaps are double-buffered
+//  the skip is only safe when the update covers
+//  the whole visible area in a single call. Any
+//  change to the screen's own palette forces a
+//  redraw; drivers that resolve colors through
+//  some other palette must call mark_all_dirty
+//  when it changes
+//-------------------------------------------------
+
+bool screen_device::update_needed(const rectangle &cliprect) const
+{
+	if (cliprect != m_visarea)
+		return true;
+	if (m_palette != NULL && m_palette->palette()->serial() != m_dirty_palette_serial)
+		return true;
+	return !m_dirty_region.empty();
+}
+
+
 //-------------------------------------------------
 //  update_now - perform an update from the last
 //  beam position up to the current beam position
@@ -670,11 +742,96 @@ void screen_device::update_now()
 void screen_device::reset_partial_updates()
 {
 	m_last_partial_scan = 0;
+	m_partial_updates_last_frame = m_partial_updates_this_frame;
 	m_partial_updates_this_frame = 0;
 	m_scanline0_timer->adjust(time_until_pos(0));
 }
 
 
+//-------------------------------------------------
+//  set_raster_registers - allocate 'count'
+//  batched raster registers, all starting at 0;
+//  must be called while the machine is starting
+//  so the values can be saved
+//-------------------------------------------------
+
+void screen_device::set_raster_registers(int count)
+{
+	assert(count > 0);
+	m_raster_start.resize_and_clear(count);
+	m_raster_current.resize_and_clear(count);
+	m_raster_log.resize(0);
+	save_pointer(&m_raster_current[0], "m_raster_current", count);
+}
+
+
+//-------------------------------------------------
+//  raster_write - log a raster register write
+//  that applies from 'scanline' onward in the
+//  current frame; the default scanline is the
+//  one after the beam, matching a call to
+//  update_partial(vpos()) before the write
+//-------------------------------------------------
+
+void screen_device::raster_write(int reg, UINT32 value, int scanline)
+{
+	assert(reg < m_raster_current.count());
+	if (m_raster_current[reg] == value)
+		return;
+	m_raster_current[reg] = value;
+
+	raster_change &change = m_raster_log.append();
+	change.scanline = scanline;
+	change.reg = reg;
+	change.value = value;
+}
+
+
+//-------------------------------------------------
+//  raster_read - return the value a register had
+//  on the given scanline of the current frame
+//-------------------------------------------------
+
+UINT32 screen_device::raster_read(int reg, int scanline) const
+{
+	assert(reg < m_raster_start.count());
+	UINT32 value = m_raster_start[reg];
+	for (int index = 0; index < m_raster_log.count(); index++)
+		if (m_raster_log[index].reg == reg && m_raster_log[index].scanline <= scanline)
+			value = m_raster_log[index].value;
+	return value;
+}
+
+
+//-------------------------------------------------
+//  raster_span_end - return the last scanline, no
+//  greater than max_y, that shares the register
+//  state of 'scanline'
+//-------------------------------------------------
+
+int screen_device::raster_span_end(int scanline, int max_y) const
+{
+	int result = max_y;
+	for (int index = 0; index < m_raster_log.count(); index++)
+		if (m_raster_log[index].scanline > scanline && m_raster_log[index].scanline - 1 < result)
+			result = m_raster_log[index].scanline - 1;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  raster_frame_start - fold the previous frame's
+//  raster writes into the starting values
+//-------------------------------------------------
+
+void screen_device::raster_frame_start()
+{
+	for (int reg = 0; reg < m_raster_start.count(); reg++)
+		m_raster_start[reg] = m_raster_current[reg];
+	m_raster_log.resize(0);
+}
+
+
 //-------------------------------------------------
 //  vpos - returns the current vertical position
 //  of the beam
@@ -878,7 +1035,7 @@ bool screen_device::update_quads()
 			{
 				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
 				m_curtexture = m_curbitmap;
-				m_curbitmap = 1 - m_curbitmap;
+				m_curbitmap = (m_curbitmap + 1) % m_numbitmaps;
 			}
 
 			// create an empty container with a single quad
@@ -209,10 +209,26 @@ public:
 
 	// updating
 	int partial_updates() const { return m_partial_updates_this_frame; }
+	int partial_updates_last_frame() const { return m_partial_updates_last_frame; }
 	bool update_partial(int scanline);
 	void update_now();
 	void reset_partial_updates();
 
+	// dirty region tracking
+	void mark_dirty(const rectangle &rect);
+	void mark_all_dirty() { m_dirty_region = m_visarea; }
+	const rectangle &dirty_region() const { return m_dirty_region; }
+	bool update_needed(const rectangle &cliprect) const;
+
+	// raster register batching; instead of calling update_partial() before
+	// each raster split, drivers log register writes here and split their
+	// screen update into spans of lines that share the same register state
+	void set_raster_registers(int count);
+	void raster_write(int reg, UINT32 value) { raster_write(reg, value, vpos() + 1); }
+	void raster_write(int reg, UINT32 value, int scanline);
+	UINT32 raster_read(int reg, int scanline) const;
+	int raster_span_end(int scanline, int max_y) const;
+
 	// additional helpers
 	void register_vblank_callback(vblank_state_delegate vblank_callback);
 	void register_screen_bitmap(bitmap_t &bitmap);
@@ -246,6 +262,7 @@ private:
 	// internal helpers
 	void set_container(render_container &container) { m_container = &container; }
 	void realloc_screen_bitmaps();
+	void raster_frame_start();
 	void vblank_begin();
 	void vblank_end();
 	void finalize_burnin();
@@ -274,13 +291,16 @@ private:
 
 	// textures and bitmaps
 	texture_format      m_texformat;                // texture format
-	render_texture *    m_texture[2];               // 2x textures for the screen bitmap
-	screen_bitmap       m_bitmap[2];                // 2x bitmaps for rendering
+	render_texture *    m_texture[3];               // up to 3x textures for the screen bitmap
+	screen_bitmap       m_bitmap[3];                // up to 3x bitmaps for rendering
 	bitmap_ind8         m_priority;                 // priority bitmap
 	bitmap_ind64        m_burnin;                   // burn-in bitmap
 	UINT8               m_curbitmap;                // current bitmap index
 	UINT8               m_curtexture;               // current texture index
+	UINT8               m_numbitmaps;               // number of bitmaps in rotation (3 when pipelined)
 	bool                m_changed;                  // has this bitmap changed?
+	rectangle           m_dirty_region;             // area changed since the last full-frame update
+	UINT32              m_dirty_palette_serial;     // palette serial at the last full-frame update
 	INT32               m_last_partial_scan;        // scanline of last partial update
 	bitmap_argb32       m_screen_overlay_bitmap;    // screen overlay bitmap
 	UINT32              m_unique_id;                // unique id for this screen_device
@@ -298,6 +318,18 @@ private:
 	emu_timer *         m_scanline_timer;           // scanline timer
 	UINT64              m_frame_number;             // the current frame number
 	UINT32              m_partial_updates_this_frame;// partial update counter this frame
+	UINT32              m_partial_updates_last_frame;// partial update count for the previous frame
+
+	// raster register batching
+	struct raster_change
+	{
+		INT32           scanline;                   // first scanline the value applies to
+		INT32           reg;                        // register index
+		UINT32          value;                      // new value
+	};
+	dynamic_array<UINT32> m_raster_start;           // register values at the start of the frame
+	dynamic_array<UINT32> m_raster_current;         // most recently written register values
+	dynamic_array<raster_change> m_raster_log;      // changes logged during this frame
 
 	// VBLANK callbacks
 	class callback_item
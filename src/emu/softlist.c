@@ -86,6 +86,61 @@ private:
 };
 
 
+// ======================> softlist_cache
+
+// a compact binary image of a parsed list, stored in the cfg directory and
+// keyed on the size and CRC of the XML it was built from; strings are stored
+// once in a shared table and interned into the list's pool on load
+class softlist_cache
+{
+public:
+	// construction
+	softlist_cache(software_list_device &list, UINT32 xmlsize, UINT32 xmlcrc);
+
+	// operations
+	bool load();
+	void save();
+
+private:
+	// bump the last digit whenever the layout or the parser's output changes
+	static const UINT32 MAGIC = 0x534c4331;   // 'SLC1'
+
+	// header layout, in words
+	enum
+	{
+		HEADER_MAGIC,
+		HEADER_XMLSIZE,
+		HEADER_XMLCRC,
+		HEADER_STRINGS,
+		HEADER_STRINGBYTES,
+		HEADER_WORDS,
+		HEADER_COUNT
+	};
+
+	// writing helpers
+	void write_string(const char *string);
+	void write_features(feature_list_item *first);
+
+	// reading helpers
+	bool read_word(UINT32 &value) { if (m_read >= m_readend) return false; value = *m_read++; return true; }
+	bool read_count(UINT32 &value) { return read_word(value) && value <= UINT32(m_readend - m_read); }
+	bool read_string(const char *&string);
+	bool read_features(simple_list<feature_list_item> &list);
+	bool read_list();
+
+	// internal state
+	software_list_device &      m_list;
+	UINT32                      m_xmlsize;
+	UINT32                      m_xmlcrc;
+	dynamic_array<UINT32>       m_words;          // record stream
+	dynamic_buffer              m_strings;        // NUL-terminated string table
+	tagmap_t<UINT32, 4093>      m_stringmap;      // string to table index + 1
+	dynamic_array<const char *> m_stringlist;     // interned strings by index
+	const UINT32 *              m_read;           // current read position
+	const UINT32 *              m_readend;        // end of the record stream
+};
+
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -468,6 +523,7 @@ void software_list_device::release()
 	m_parsed = false;
 	m_description = NULL;
 	m_errors.reset();
+	m_infomap.reset();
 	m_infolist.reset();
 	m_stringpool.reset();
 }
@@ -544,6 +600,15 @@ software_info *software_list_device::find(const char *look_for, software_info *p
 
 	bool iswild = strchr(look_for, '*') != NULL || strchr(look_for, '?');
 
+	// exact names come straight from the index
+	if (!iswild && prev == NULL)
+	{
+		if (!m_parsed)
+			parse();
+		astring lowername(look_for);
+		return m_infomap.find(lowername.makelower());
+	}
+
 	// find a match (will cause a parse if needed when calling first_software_info)
 	for (prev = (prev != NULL) ? prev->next() : first_software_info(); prev != NULL; prev = prev->next())
 		if ((iswild && core_strwildcmp(look_for, prev->shortname()) == 0) || core_stricmp(look_for, prev->shortname()) == 0)
@@ -570,13 +635,27 @@ void software_list_device::parse()
 	file_error filerr = m_file.open(m_list_name, ".xml");
 	if (filerr == FILERR_NONE)
 	{
-		// parse if no error
-		softlist_parser parser(*this, m_errors);
+		// use the binary image if it was built from this exact XML
+		UINT32 xmlcrc = 0;
+		m_file.hashes(hash_collection::HASH_TYPES_CRC).crc(xmlcrc);
+		softlist_cache cache(*this, m_file.size(), xmlcrc);
+		if (!cache.load())
+		{
+			// parse if no error, and refresh the image if the list is clean
+			softlist_parser parser(*this, m_errors);
+			if (!m_errors)
+				cache.save();
+		}
 		m_file.close();
 	}
 	else
 		m_errors.printf("Error opening file: %s\n", filename());
 
+	// index the short names for find()
+	astring lowername;
+	for (software_info *swinfo = m_infolist.first(); swinfo != NULL; swinfo = swinfo->next())
+		m_infomap.add(lowername.cpy(swinfo->shortname()).makelower(), swinfo);
+
 	// indicate that we've been parsed
 	m_parsed = true;
 }
@@ -728,6 +807,288 @@ void software_list_device::internal_validity_check(validity_checker &valid)
 
 
 
+//**************************************************************************
+//  SOFTWARE LIST CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  softlist_cache - constructor
+//-------------------------------------------------
+
+softlist_cache::softlist_cache(software_list_device &list, UINT32 xmlsize, UINT32 xmlcrc)
+	: m_list(list),
+		m_xmlsize(xmlsize),
+		m_xmlcrc(xmlcrc),
+		m_read(NULL),
+		m_readend(NULL)
+{
+}
+
+
+//-------------------------------------------------
+//  load - populate the list from its binary
+//  image; returns false (leaving the list empty)
+//  if there is no usable image
+//-------------------------------------------------
+
+bool softlist_cache::load()
+{
+	emu_file file(m_list.mconfig().options().cfg_directory(), OPEN_FLAG_READ);
+	if (file.open("softlist" PATH_SEPARATOR, m_list.list_name(), ".bin") != FILERR_NONE)
+		return false;
+
+	// the image must have been built from this exact XML
+	UINT32 header[HEADER_COUNT];
+	if (file.read(header, sizeof(header)) != sizeof(header) || header[HEADER_MAGIC] != MAGIC ||
+		header[HEADER_XMLSIZE] != m_xmlsize || header[HEADER_XMLCRC] != m_xmlcrc ||
+		UINT64(header[HEADER_STRINGBYTES]) + UINT64(header[HEADER_WORDS]) * 4 + sizeof(header) != file.size())
+		return false;
+
+	// read the string table and intern each string into the list's pool
+	m_strings.resize(header[HEADER_STRINGBYTES]);
+	if (file.read(m_strings, m_strings.count()) != m_strings.count() || (m_strings.count() != 0 && m_strings[m_strings.count() - 1] != 0))
+		return false;
+	for (int offset = 0; offset < m_strings.count(); offset += strlen((const char *)&m_strings[offset]) + 1)
+		m_stringlist.append(m_list.add_string((const char *)&m_strings[offset]));
+	if (m_stringlist.count() != header[HEADER_STRINGS])
+	{
+		m_list.m_stringpool.reset();
+		return false;
+	}
+
+	// read and decode the records
+	m_words.resize(header[HEADER_WORDS]);
+	if (file.read(m_words, m_words.bytes()) != m_words.bytes())
+	{
+		m_list.m_stringpool.reset();
+		return false;
+	}
+	m_read = m_words;
+	m_readend = m_read + m_words.count();
+	if (!read_list())
+	{
+		m_list.m_description = NULL;
+		m_list.m_infolist.reset();
+		m_list.m_stringpool.reset();
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save - write the binary image of the list as
+//  it stands now
+//-------------------------------------------------
+
+void softlist_cache::save()
+{
+	// encode the list: description and entry count, then each entry
+	write_string(m_list.m_description);
+	m_words.append(m_list.m_infolist.count());
+	for (software_info *swinfo = m_list.m_infolist.first(); swinfo != NULL; swinfo = swinfo->next())
+	{
+		write_string(swinfo->m_shortname);
+		write_string(swinfo->m_parentname);
+		write_string(swinfo->m_longname);
+		write_string(swinfo->m_year);
+		write_string(swinfo->m_publisher);
+		m_words.append(swinfo->m_supported);
+		write_features(swinfo->other_info());
+		write_features(swinfo->shared_info());
+
+		// parts, each with its features and ROM entries
+		m_words.append(swinfo->m_partdata.count());
+		for (software_part *part = swinfo->first_part(); part != NULL; part = part->next())
+		{
+			write_string(part->m_name);
+			write_string(part->m_interface);
+			write_features(part->featurelist());
+			m_words.append(part->m_romdata.count());
+			for (int romnum = 0; romnum < part->m_romdata.count(); romnum++)
+			{
+				const rom_entry &entry = part->m_romdata[romnum];
+				m_words.append(entry._flags);
+				write_string(entry._name);
+
+				// fill entries carry their value in the hash pointer
+				if ((entry._flags & ROMENTRY_TYPEMASK) == ROMENTRYTYPE_FILL)
+					m_words.append(UINT32(FPTR(entry._hashdata)));
+				else
+					write_string(entry._hashdata);
+				m_words.append(entry._offset);
+				m_words.append(entry._length);
+			}
+		}
+	}
+
+	UINT32 header[HEADER_COUNT];
+	header[HEADER_MAGIC] = MAGIC;
+	header[HEADER_XMLSIZE] = m_xmlsize;
+	header[HEADER_XMLCRC] = m_xmlcrc;
+	header[HEADER_STRINGS] = m_stringlist.count();
+	header[HEADER_STRINGBYTES] = m_strings.count();
+	header[HEADER_WORDS] = m_words.count();
+
+	emu_file file(m_list.mconfig().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open("softlist" PATH_SEPARATOR, m_list.list_name(), ".bin") == FILERR_NONE)
+	{
+		file.write(header, sizeof(header));
+		file.write(m_strings, m_strings.count());
+		file.write(m_words, m_words.bytes());
+	}
+}
+
+
+//-------------------------------------------------
+//  write_string - append a reference to a string,
+//  adding it to the table the first time it is
+//  seen; 0 means NULL
+//-------------------------------------------------
+
+void softlist_cache::write_string(const char *string)
+{
+	if (string == NULL)
+	{
+		m_words.append(0);
+		return;
+	}
+
+	// reuse an existing copy if we have one
+	UINT32 index = m_stringmap.find(string);
+	if (index == 0)
+	{
+		int offset = m_strings.count();
+		int bytes = strlen(string) + 1;
+		m_strings.resize_keep(offset + bytes);
+		memcpy(&m_strings[offset], string, bytes);
+		m_stringlist.append(string);
+		index = m_stringlist.count();
+		m_stringmap.add(string, index);
+	}
+	m_words.append(index);
+}
+
+
+//-------------------------------------------------
+//  write_features - append a counted list of
+//  name/value pairs
+//-------------------------------------------------
+
+void softlist_cache::write_features(feature_list_item *first)
+{
+	int countpos = m_words.count();
+	m_words.append(0);
+	for (feature_list_item *item = first; item != NULL; item = item->next())
+	{
+		write_string(item->name());
+		write_string(item->value());
+		m_words[countpos]++;
+	}
+}
+
+
+//-------------------------------------------------
+//  read_string - decode a string reference
+//-------------------------------------------------
+
+bool softlist_cache::read_string(const char *&string)
+{
+	UINT32 index;
+	if (!read_word(index) || index > UINT32(m_stringlist.count()))
+		return false;
+	string = (index == 0) ? NULL : m_stringlist[index - 1];
+	return true;
+}
+
+
+//-------------------------------------------------
+//  read_features - decode a counted list of
+//  name/value pairs
+//-------------------------------------------------
+
+bool softlist_cache::read_features(simple_list<feature_list_item> &list)
+{
+	UINT32 count;
+	if (!read_count(count))
+		return false;
+	while (count-- != 0)
+	{
+		const char *name, *value;
+		if (!read_string(name) || !read_string(value))
+			return false;
+		list.append(*global_alloc(feature_list_item(name, value)));
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  read_list - decode the whole record stream
+//  into the list
+//-------------------------------------------------
+
+bool softlist_cache::read_list()
+{
+	UINT32 infocount;
+	if (!read_string(m_list.m_description) || !read_count(infocount))
+		return false;
+
+	while (infocount-- != 0)
+	{
+		const char *name, *parent;
+		UINT32 supported;
+		if (!read_string(name) || !read_string(parent))
+			return false;
+		software_info &swinfo = m_list.m_infolist.append(*global_alloc(software_info(m_list, name, parent, NULL)));
+		if (!read_string(swinfo.m_longname) || !read_string(swinfo.m_year) || !read_string(swinfo.m_publisher) || !read_word(supported))
+			return false;
+		swinfo.m_supported = supported;
+		if (!read_features(swinfo.m_other_info) || !read_features(swinfo.m_shared_info))
+			return false;
+
+		UINT32 partcount;
+		if (!read_count(partcount))
+			return false;
+		while (partcount-- != 0)
+		{
+			const char *partname, *interface;
+			if (!read_string(partname) || !read_string(interface))
+				return false;
+			software_part &part = swinfo.m_partdata.append(*global_alloc(software_part(swinfo, partname, interface)));
+			if (!read_features(part.m_featurelist))
+				return false;
+
+			UINT32 romcount;
+			if (!read_count(romcount))
+				return false;
+			part.m_romdata.resize(romcount);
+			for (UINT32 romnum = 0; romnum < romcount; romnum++)
+			{
+				rom_entry &entry = part.m_romdata[romnum];
+				if (!read_word(entry._flags) || !read_string(entry._name))
+					return false;
+				if ((entry._flags & ROMENTRY_TYPEMASK) == ROMENTRYTYPE_FILL)
+				{
+					UINT32 value;
+					if (!read_word(value))
+						return false;
+					entry._hashdata = (const char *)(FPTR)(value & 0xff);
+				}
+				else if (!read_string(entry._hashdata))
+					return false;
+				if (!read_word(entry._offset) || !read_word(entry._length))
+					return false;
+			}
+		}
+	}
+
+	// everything must have been consumed
+	return (m_read == m_readend);
+}
+
+
+
 //**************************************************************************
 //  SOFTWARE LIST PARSER
 //**************************************************************************
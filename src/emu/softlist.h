@@ -100,6 +100,7 @@ private:
 class software_part
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 	friend class simple_list<software_part>;
 
 public:
@@ -136,6 +137,7 @@ private:
 class software_info
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 	friend class simple_list<software_info>;
 
 public:
@@ -184,6 +186,7 @@ private:
 class software_list_device : public device_t
 {
 	friend class softlist_parser;
+	friend class softlist_cache;
 
 public:
 	// construction/destruction
@@ -238,6 +241,7 @@ protected:
 	const char *                m_description;
 	astring                     m_errors;
 	simple_list<software_info>  m_infolist;
+	tagmap_t<software_info *, 1543> m_infomap;  // lowercase short name to first matching info
 	const_string_pool           m_stringpool;
 };
 
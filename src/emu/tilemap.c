@@ -10,6 +10,13 @@
 
 #include "emu.h"
 
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define TILEMAP_SSE2 1
+#include <emmintrin.h>
+#else
+#define TILEMAP_SSE2 0
+#endif
+
 
 //**************************************************************************
 //  INLINE FUNCTIONS
@@ -185,11 +192,41 @@ inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *so
 inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
 {
 	int pal = pcode >> 16;
+	int i = 0;
+
+#if TILEMAP_SSE2
+	// select 8 pixels at a time; unselected pixels are written back unchanged
+	const __m128i maskv = _mm_set1_epi8(mask);
+	const __m128i valuev = _mm_set1_epi8(value);
+	const __m128i palv = _mm_set1_epi16(pal);
+	const __m128i primaskv = _mm_set1_epi8(pcode >> 8);
+	const __m128i pricodev = _mm_set1_epi8(pcode);
+	const bool dopri = ((pcode & 0xffff) != 0xff00);
+	for ( ; i + 8 <= count; i += 8)
+	{
+		__m128i sel8 = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadl_epi64((const __m128i *)&maskptr[i]), maskv), valuev);
+		int const bits = _mm_movemask_epi8(sel8) & 0xff;
+		if (bits == 0)
+			continue;
+
+		__m128i sel16 = _mm_unpacklo_epi8(sel8, sel8);
+		__m128i src = _mm_add_epi16(_mm_loadu_si128((const __m128i *)&source[i]), palv);
+		__m128i dst = _mm_loadu_si128((const __m128i *)&dest[i]);
+		_mm_storeu_si128((__m128i *)&dest[i], _mm_or_si128(_mm_and_si128(sel16, src), _mm_andnot_si128(sel16, dst)));
+
+		if (dopri)
+		{
+			__m128i p = _mm_loadl_epi64((const __m128i *)&pri[i]);
+			__m128i np = _mm_or_si128(_mm_and_si128(p, primaskv), pricodev);
+			_mm_storel_epi64((__m128i *)&pri[i], _mm_or_si128(_mm_and_si128(sel8, np), _mm_andnot_si128(sel8, p)));
+		}
+	}
+#endif
 
 	// priority case
 	if ((pcode & 0xffff) != 0xff00)
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 			{
 				dest[i] = source[i] + pal;
@@ -200,7 +237,7 @@ inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *so
 	// no priority case
 	else
 	{
-		for (int i = 0; i < count; i++)
+		for ( ; i < count; i++)
 			if ((maskptr[i] & mask) == value)
 				dest[i] = source[i] + pal;
 	}
@@ -385,6 +422,14 @@ tilemap_t &tilemap_t::init(tilemap_manager &manager, device_gfx_interface &decod
 	m_dy = 0;
 	m_dy_flipped = 0;
 
+	// everything starts out dirty
+	m_dirty_region.set(0, m_width - 1, 0, m_height - 1);
+	m_dirty_enable = true;
+	m_dirty_attributes = 0;
+	m_dirty_palette_offset = 0;
+	m_dirty_scrollx = 0;
+	m_dirty_scrolly = 0;
+
 	// allocate pixmap
 	m_pixmap.allocate(m_width, m_height);
 
@@ -450,11 +495,85 @@ void tilemap_t::mark_tile_dirty(tilemap_memory_index memindex)
 		{
 			m_tileflags[logindex] = TILE_FLAG_DIRTY;
 			m_all_tiles_clean = false;
+
+			// accumulate the tile's pixels into the dirty region
+			int x = (logindex % m_cols) * m_tilewidth;
+			int y = (logindex / m_cols) * m_tileheight;
+			rectangle tilerect(x, x + m_tilewidth - 1, y, y + m_tileheight - 1);
+			if (m_dirty_region.empty())
+				m_dirty_region = tilerect;
+			else
+				m_dirty_region |= tilerect;
 		}
 	}
 }
 
 
+//-------------------------------------------------
+//  screen_dirty_region - return the bounding box,
+//  in screen coordinates and clipped to cliprect,
+//  of everything a draw would change since the
+//  last reset_dirty_region; scroll, flip, enable
+//  or palette offset changes dirty the whole clip
+//-------------------------------------------------
+
+rectangle tilemap_t::screen_dirty_region(screen_device &screen, const rectangle &cliprect)
+{
+	// graphics changes dirty everything; this also primes the next draw
+	if (gfx_elements_changed())
+		mark_all_dirty();
+
+	rectangle visarea = screen.visible_area();
+	UINT32 width = visarea.min_x + visarea.max_x + 1;
+	UINT32 height = visarea.min_y + visarea.max_y + 1;
+
+	// per-row or per-column scrolling, or any global state change, dirties the whole clip
+	if (m_scrollrows != 1 || m_scrollcols != 1 || m_enable != m_dirty_enable || m_attributes != m_dirty_attributes ||
+		m_palette_offset != m_dirty_palette_offset || scrolldx() - m_rowscroll[0] != m_dirty_scrollx || scrolldy() - m_colscroll[0] != m_dirty_scrolly)
+		return cliprect;
+
+	// nothing to do if nothing changed, or if we're not drawn at all
+	rectangle result(0, -1, 0, -1);
+	if (m_dirty_region.empty() || !m_enable)
+		return result;
+
+	// union the dirty region of every wrapped instance that intersects the clip
+	int scrollx = effective_rowscroll(0, width);
+	int scrolly = effective_colscroll(0, height);
+	for (int ypos = scrolly - m_height; ypos <= cliprect.max_y; ypos += m_height)
+		for (int xpos = scrollx - m_width; xpos <= cliprect.max_x; xpos += m_width)
+		{
+			rectangle instance = m_dirty_region;
+			instance.offset(xpos, ypos);
+			instance &= cliprect;
+			if (instance.empty())
+				continue;
+			if (result.empty())
+				result = instance;
+			else
+				result |= instance;
+		}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  reset_dirty_region - clear the dirty region and
+//  snapshot the state screen_dirty_region compares
+//  against
+//-------------------------------------------------
+
+void tilemap_t::reset_dirty_region()
+{
+	m_dirty_region.set(0, -1, 0, -1);
+	m_dirty_enable = m_enable;
+	m_dirty_attributes = m_attributes;
+	m_dirty_palette_offset = m_palette_offset;
+	m_dirty_scrollx = scrolldx() - m_rowscroll[0];
+	m_dirty_scrolly = scrolldy() - m_colscroll[0];
+}
+
+
 //-------------------------------------------------
 //  map_pens_to_layer - specify the mapping of one
 //  or more pens (where (<pen> & mask) == pen) to
@@ -946,6 +1065,24 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
+	// large banded draws are split across the manager's work queue
+	if ((flags & TILEMAP_DRAW_BANDED) && blit.cliprect.height() >= 2 * DRAW_BAND_MIN_LINES && m_manager->work_queue() != NULL)
+		draw_banded(screen, dest, blit);
+	else
+		draw_scrolled(screen, dest, blit);
+g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  draw_scrolled - draw all visible instances of
+//  the tilemap that intersect blit.cliprect,
+//  honoring the row and column scroll values
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_scrolled(screen_device &screen, _BitmapClass &dest, blit_parameters &blit)
+{
 	// flip the tilemap around the center of the visible area
 	rectangle visarea = screen.visible_area();
 	UINT32 width = visarea.min_x + visarea.max_x + 1;
@@ -1036,9 +1173,64 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 			}
 		}
 	}
-g_profiler.stop();
 }
 
+
+//-------------------------------------------------
+//  draw_banded - split a draw into horizontal
+//  bands of scanlines and render them in
+//  parallel; every tile is brought up to date
+//  first so the workers never call tile_update
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void tilemap_t::draw_banded(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit)
+{
+	// realize every dirty tile up front; the workers only read the pixmap
+	pixmap_update();
+
+	// divide the clip into at most DRAW_BANDS bands of at least DRAW_BAND_MIN_LINES
+	int const height = blit.cliprect.height();
+	int const numbands = MIN(DRAW_BANDS, height / DRAW_BAND_MIN_LINES);
+	int const bandheight = (height + numbands - 1) / numbands;
+
+	draw_band bands[DRAW_BANDS];
+	int count = 0;
+	for (int y = blit.cliprect.min_y; y <= blit.cliprect.max_y; y += bandheight)
+	{
+		draw_band &band = bands[count++];
+		band.tmap = this;
+		band.screen = &screen;
+		band.dest = &dest;
+		band.blit = blit;
+		band.blit.cliprect.min_y = y;
+		band.blit.cliprect.max_y = MIN(y + bandheight - 1, blit.cliprect.max_y);
+	}
+
+	// queue the bands; auto-released items return NULL, so there's nothing to check
+	osd_work_queue *queue = m_manager->work_queue();
+	osd_work_item_queue_multiple(queue, draw_band_callback<_BitmapClass>, count, bands, sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+
+	// the bands live on our stack, so don't leave until every one is done
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10))
+		;
+}
+
+
+//-------------------------------------------------
+//  draw_band_callback - worker entry point for a
+//  single band of a banded draw
+//-------------------------------------------------
+
+template<class _BitmapClass>
+void *tilemap_t::draw_band_callback(void *param, int threadid)
+{
+	draw_band &band = *reinterpret_cast<draw_band *>(param);
+	band.tmap->draw_scrolled(*band.screen, *reinterpret_cast<_BitmapClass *>(band.dest), band.blit);
+	return NULL;
+}
+
+
 void tilemap_t::draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask)
 { draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
 
@@ -1484,7 +1676,8 @@ void tilemap_t::draw_debug(screen_device &screen, bitmap_rgb32 &dest, UINT32 scr
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_queue(NULL)
 {
 }
 
@@ -1495,6 +1688,10 @@ tilemap_manager::tilemap_manager(running_machine &machine)
 
 tilemap_manager::~tilemap_manager()
 {
+	// free the banded draw queue
+	if (m_queue != NULL)
+		osd_work_queue_free(m_queue);
+
 	// detach all device tilemaps since they will be destroyed
 	// as subdevices elsewhere
 	bool found = true;
@@ -1560,6 +1757,19 @@ void tilemap_manager::set_flip_all(UINT32 attributes)
 }
 
 
+//-------------------------------------------------
+//  work_queue - return the queue used for banded
+//  draws, allocating it on first use
+//-------------------------------------------------
+
+osd_work_queue *tilemap_manager::work_queue()
+{
+	if (m_queue == NULL)
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	return m_queue;
+}
+
+
 //-------------------------------------------------
 //  mark_all_dirty - mark all the tiles in all the
 //  tilemaps dirty
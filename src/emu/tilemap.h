@@ -320,6 +320,7 @@ const UINT32 TILEMAP_DRAW_LAYER2 = 0x40;            // draw layer 2
 const UINT32 TILEMAP_DRAW_OPAQUE = 0x80;            // draw everything, even transparent stuff
 const UINT32 TILEMAP_DRAW_ALPHA_FLAG = 0x100;       // draw with alpha blending (in the upper 8 bits)
 const UINT32 TILEMAP_DRAW_ALL_CATEGORIES = 0x200;   // draw all categories
+const UINT32 TILEMAP_DRAW_BANDED = 0x400;           // split large draws into scanline bands across worker threads
 
 // per-pixel flags in the transparency_bitmap
 const UINT8 TILEMAP_PIXEL_CATEGORY_MASK = 0x0f;     // category is stored in the low 4 bits
@@ -486,6 +487,10 @@ class tilemap_t
 	// maximum index in each array
 	static const int MAX_PEN_TO_FLAGS = 256;
 
+	// banded drawing limits
+	static const int DRAW_BANDS = 8;
+	static const int DRAW_BAND_MIN_LINES = 16;
+
 protected:
 	// tilemap_manager controlls our allocations
 	tilemap_t();
@@ -532,7 +537,12 @@ public:
 
 	// dirtying
 	void mark_tile_dirty(tilemap_memory_index memindex);
-	void mark_all_dirty() { m_all_tiles_dirty = true; m_all_tiles_clean = false; }
+	void mark_all_dirty() { m_all_tiles_dirty = true; m_all_tiles_clean = false; m_dirty_region.set(0, m_width - 1, 0, m_height - 1); }
+
+	// dirty region tracking
+	const rectangle &dirty_region() const { return m_dirty_region; }
+	rectangle screen_dirty_region(screen_device &screen, const rectangle &cliprect);
+	void reset_dirty_region();
 
 	// pen mapping
 	void map_pens_to_layer(int group, pen_t pen, pen_t mask, UINT8 layermask);
@@ -587,6 +597,15 @@ private:
 		UINT8               alpha;
 	};
 
+	// one band of a banded draw
+	struct draw_band
+	{
+		tilemap_t *         tmap;
+		screen_device *     screen;
+		void *              dest;
+		blit_parameters     blit;
+	};
+
 	// inline helpers
 	INT32 effective_rowscroll(int index, UINT32 screen_width);
 	INT32 effective_colscroll(int index, UINT32 screen_height);
@@ -615,6 +634,9 @@ private:
 	UINT8 tile_apply_bitmask(const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
+	template<class _BitmapClass> void draw_scrolled(screen_device &screen, _BitmapClass &dest, blit_parameters &blit);
+	template<class _BitmapClass> void draw_banded(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit);
+	template<class _BitmapClass> static void *draw_band_callback(void *param, int threadid);
 	template<class _BitmapClass> void draw_roz_common(screen_device &screen, _BitmapClass &dest, const rectangle &cliprect, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound, UINT32 flags, UINT8 priority, UINT8 priority_mask);
 	template<class _BitmapClass> void draw_instance(screen_device &screen, _BitmapClass &dest, const blit_parameters &blit, int xpos, int ypos);
 	template<class _BitmapClass> void draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit, UINT32 startx, UINT32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound);
@@ -666,6 +688,14 @@ private:
 	INT32                       m_dy;                   // global vertical scroll offset
 	INT32                       m_dy_flipped;           // global vertical scroll offset when flipped
 
+	// dirty region tracking
+	rectangle                   m_dirty_region;         // tilemap pixels changed since reset_dirty_region
+	bool                        m_dirty_enable;         // m_enable at the last reset
+	UINT8                       m_dirty_attributes;     // m_attributes at the last reset
+	UINT32                      m_dirty_palette_offset; // m_palette_offset at the last reset
+	INT32                       m_dirty_scrollx;        // scroll X offset at the last reset
+	INT32                       m_dirty_scrolly;        // scroll Y offset at the last reset
+
 	// pixel data
 	bitmap_ind16                m_pixmap;               // cached pixel data
 
@@ -690,6 +720,7 @@ public:
 
 	// getters
 	running_machine &machine() const { return m_machine; }
+	osd_work_queue *work_queue();
 
 	// tilemap creation
 	tilemap_t &create(device_gfx_interface &decoder, tilemap_get_info_delegate tile_get_info, tilemap_mapper_delegate mapper, int tilewidth, int tileheight, int cols, int rows, tilemap_t *allocated = NULL);
@@ -711,6 +742,7 @@ private:
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_queue;                // work queue for banded draws, allocated on first use
 };
 
 
@@ -12,6 +12,13 @@
 #include "validity.h"
 #include "emuopts.h"
 #include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+// older MSVC lacks va_copy; its va_list is a plain pointer
+#ifndef va_copy
+#define va_copy(dst, src) ((dst) = (src))
+#endif
 
 
 //**************************************************************************
@@ -31,6 +38,23 @@ UINT8 your_ptr64_flag_is_wrong[(int)(5 - sizeof(void *))];
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+#ifdef _MSC_VER
+#define VALIDITY_THREAD_LOCAL __declspec(thread)
+#else
+#define VALIDITY_THREAD_LOCAL __thread
+#endif
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// the OSD output channels are process-wide, so during a parallel check the
+// owning checker forwards errors to the worker checker of the calling thread
+static VALIDITY_THREAD_LOCAL validity_checker *s_thread_checker;
+
+
 //**************************************************************************
 //  INLINE FUNCTIONS
 //**************************************************************************
@@ -130,8 +154,12 @@ validity_checker::validity_checker(emu_options &options)
 		m_current_driver(NULL),
 		m_current_config(NULL),
 		m_current_device(NULL),
-		m_current_ioport(NULL)
+		m_current_ioport(NULL),
+		m_owner(NULL),
+		m_checked_lock(NULL)
 {
+	memset(m_workers, 0, sizeof(m_workers));
+
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
 	{
@@ -141,13 +169,58 @@ validity_checker::validity_checker(emu_options &options)
 	}
 }
 
+//-------------------------------------------------
+//  validity_checker - constructor for a worker
+//  of a parallel run; it starts in the state
+//  validate_begin() leaves its owner in, and
+//  holds its report until the owner writes it
+//-------------------------------------------------
+
+validity_checker::validity_checker(validity_checker &owner)
+	: m_drivlist(owner.m_drivlist.options()),
+		m_errors(0),
+		m_warnings(0),
+		m_current_driver(NULL),
+		m_current_config(NULL),
+		m_current_device(NULL),
+		m_current_ioport(NULL),
+		m_saved_error_output(FUNC(validity_checker::deferred_output), this),
+		m_saved_warning_output(FUNC(validity_checker::deferred_output), this),
+		m_owner(&owner),
+		m_checked_lock(NULL)
+{
+	memset(m_workers, 0, sizeof(m_workers));
+}
+
 //-------------------------------------------------
 //  validity_checker - destructor
 //-------------------------------------------------
 
 validity_checker::~validity_checker()
 {
-	validate_end();
+	// workers never took over the output channels
+	if (m_owner == NULL)
+		validate_end();
+}
+
+
+//-------------------------------------------------
+//  already_checked - register a string, returning
+//  true if it was already registered; workers
+//  share their owner's registry so that each
+//  item is still checked only once per run
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	if (m_owner != NULL)
+	{
+		osd_lock_acquire(m_owner->m_checked_lock);
+		bool result = m_owner->already_checked(string);
+		osd_lock_release(m_owner->m_checked_lock);
+		return result;
+	}
+	return (m_already_checked.add(string, 1, false) == TMERR_DUPLICATE);
 }
 
 //-------------------------------------------------
@@ -213,16 +286,98 @@ void validity_checker::check_all()
 		output_via_delegate(m_saved_error_output, "\n");
 	}
 
-	// then iterate over all drivers and check them
+	// gather the drivers, registering every name and description up front so
+	// that duplicates are reported against the same drivers as a serial pass
+	dynamic_array<int> drivers;
 	m_drivlist.reset();
 	while (m_drivlist.next())
-		validate_one(m_drivlist.driver());
+	{
+		drivers.append(m_drivlist.current());
+		m_names_map.add(m_drivlist.driver().name, &m_drivlist.driver(), false);
+		m_descriptions_map.add(m_drivlist.driver().description, &m_drivlist.driver(), false);
+	}
+
+	// validate batches of drivers on worker threads, writing each batch's
+	// report in driver order as soon as it is done
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	m_checked_lock = osd_lock_alloc();
+	driver_batch batches[BATCHES_IN_FLIGHT];
+	int batchcount = (drivers.count() + BATCH_DRIVERS - 1) / BATCH_DRIVERS;
+	int queued = 0;
+	for (int written = 0; written < batchcount; written++)
+	{
+		// keep the window full
+		for ( ; queued < batchcount && queued < written + BATCHES_IN_FLIGHT; queued++)
+		{
+			driver_batch &batch = batches[queued % BATCHES_IN_FLIGHT];
+			batch.owner = this;
+			batch.drivers = &drivers[queued * BATCH_DRIVERS];
+			batch.count = MIN(BATCH_DRIVERS, drivers.count() - queued * BATCH_DRIVERS);
+			batch.item = (queue != NULL) ? osd_work_item_queue(queue, validate_batch, &batch, 0) : NULL;
+			if (batch.item == NULL)
+				validate_batch(&batch, WORK_MAX_THREADS);
+		}
+
+		// write out the oldest batch
+		driver_batch &batch = batches[written % BATCHES_IN_FLIGHT];
+		if (batch.item != NULL)
+		{
+			while (!osd_work_item_wait(batch.item, osd_ticks_per_second() * 10))
+				;
+			osd_work_item_release(batch.item);
+			batch.item = NULL;
+		}
+		if (batch.output)
+			output_via_delegate(m_saved_error_output, "%s", batch.output.cstr());
+		batch.output.reset();
+	}
+	if (queue != NULL)
+		osd_work_queue_free(queue);
+
+	// merge the workers' counts and free them
+	for (int workernum = 0; workernum < ARRAY_LENGTH(m_workers); workernum++)
+		if (m_workers[workernum] != NULL)
+		{
+			m_errors += m_workers[workernum]->m_errors;
+			m_warnings += m_workers[workernum]->m_warnings;
+			global_free(m_workers[workernum]);
+			m_workers[workernum] = NULL;
+		}
+	osd_lock_free(m_checked_lock);
+	m_checked_lock = NULL;
 
 	// cleanup
 	validate_end();
 }
 
 
+//-------------------------------------------------
+//  validate_batch - validate a batch of drivers
+//  with the worker checker for this thread
+//-------------------------------------------------
+
+void *validity_checker::validate_batch(void *param, int threadid)
+{
+	driver_batch &batch = *(driver_batch *)param;
+
+	// each thread keeps one worker for the whole run
+	validity_checker *&worker = batch.owner->m_workers[threadid];
+	if (worker == NULL)
+		worker = global_alloc(validity_checker(*batch.owner));
+
+	// validate with this thread's errors routed to the worker
+	s_thread_checker = worker;
+	for (int index = 0; index < batch.count; index++)
+		worker->validate_one(driver_list::driver(batch.drivers[index]));
+	s_thread_checker = NULL;
+
+	// hand the report back to be written in order
+	batch.output.cpy(worker->m_deferred_text);
+	worker->m_deferred_text.reset();
+	return NULL;
+}
+
+
 //-------------------------------------------------
 //  validate_begin - prepare for validation by
 //  taking over the output callbacks and resetting
@@ -520,20 +675,26 @@ void validity_checker::validate_inlines()
 
 void validity_checker::validate_driver()
 {
+	// workers look names and descriptions up in their owner's maps, which
+	// already hold every driver
+	game_driver_map &names_map = (m_owner != NULL) ? m_owner->m_names_map : m_names_map;
+	game_driver_map &descriptions_map = (m_owner != NULL) ? m_owner->m_descriptions_map : m_descriptions_map;
+	if (m_owner == NULL)
+	{
+		names_map.add(m_current_driver->name, m_current_driver, false);
+		descriptions_map.add(m_current_driver->description, m_current_driver, false);
+	}
+
 	// check for duplicate names
 	astring tempstr;
-	if (m_names_map.add(m_current_driver->name, m_current_driver, false) == TMERR_DUPLICATE)
-	{
-		const game_driver *match = m_names_map.find(m_current_driver->name);
+	const game_driver *match = names_map.find(m_current_driver->name);
+	if (match != m_current_driver)
 		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(tempstr, match->source_file).cstr(), match->name);
-	}
 
 	// check for duplicate descriptions
-	if (m_descriptions_map.add(m_current_driver->description, m_current_driver, false) == TMERR_DUPLICATE)
-	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->description);
+	match = descriptions_map.find(m_current_driver->description);
+	if (match != m_current_driver)
 		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(tempstr, match->source_file).cstr(), match->name);
-	}
 
 	// determine if we are a clone
 	bool is_clone = (strcmp(m_current_driver->parent, "0") != 0);
@@ -1067,6 +1228,13 @@ void validity_checker::build_output_prefix(astring &string)
 
 void validity_checker::error_output(const char *format, va_list argptr)
 {
+	// errors raised on a worker thread belong to that thread's checker
+	if (s_thread_checker != NULL && s_thread_checker != this)
+	{
+		s_thread_checker->error_output(format, argptr);
+		return;
+	}
+
 	// count the error
 	m_errors++;
 
@@ -1087,6 +1255,13 @@ void validity_checker::error_output(const char *format, va_list argptr)
 
 void validity_checker::warning_output(const char *format, va_list argptr)
 {
+	// warnings raised on a worker thread belong to that thread's checker
+	if (s_thread_checker != NULL && s_thread_checker != this)
+	{
+		s_thread_checker->warning_output(format, argptr);
+		return;
+	}
+
 	// count the error
 	m_warnings++;
 
@@ -1115,3 +1290,25 @@ void validity_checker::output_via_delegate(output_delegate &delegate, const char
 	delegate(format, argptr);
 	va_end(argptr);
 }
+
+
+//-------------------------------------------------
+//  deferred_output - collect a worker's report
+//  so its owner can write it in driver order
+//-------------------------------------------------
+
+void validity_checker::deferred_output(const char *format, va_list argptr)
+{
+	// a driver's whole report arrives in one call, which can exceed the fixed
+	// buffer behind astring::catvprintf, so measure the text first
+	va_list sizeptr;
+	va_copy(sizeptr, argptr);
+	int length = vsnprintf(NULL, 0, format, sizeptr);
+	va_end(sizeptr);
+	if (length <= 0)
+		return;
+
+	dynamic_array<char> buffer(length + 1);
+	vsnprintf(&buffer[0], length + 1, format, argptr);
+	m_deferred_text.cat(&buffer[0], length);
+}
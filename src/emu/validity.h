@@ -50,9 +50,31 @@ public:
 	int region_length(const char *tag) { return m_region_map.find(tag); }
 
 	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return (m_already_checked.add(string, 1, false) == TMERR_DUPLICATE); }
+	bool already_checked(const char *string);
 
 private:
+	// worker checker for a parallel run
+	validity_checker(validity_checker &owner);
+
+	// drivers validated together on a worker
+	static const int BATCH_DRIVERS = 16;
+	static const int BATCHES_IN_FLIGHT = 64;
+
+	// a run of consecutive drivers validated together on a worker
+	struct driver_batch
+	{
+		driver_batch() : owner(NULL), drivers(NULL), count(0), item(NULL) { }
+
+		validity_checker *  owner;              // checker running the parallel pass
+		const int *         drivers;            // driver indexes to validate
+		int                 count;              // number of drivers
+		osd_work_item *     item;               // work item, while in flight
+		astring             output;             // report text
+	};
+
+	// parallel validation
+	static void *validate_batch(void *param, int threadid);
+
 	// internal helpers
 	const char *ioport_string_from_index(UINT32 index);
 	int get_defstr_index(const char *string, bool suppress_error = false);
@@ -78,6 +100,7 @@ private:
 	void error_output(const char *format, va_list argptr);
 	void warning_output(const char *format, va_list argptr);
 	void output_via_delegate(output_delegate &delegate, const char *format, ...) ATTR_PRINTF(3,4);
+	void deferred_output(const char *format, va_list argptr);
 
 	// internal driver list
 	driver_enumerator       m_drivlist;
@@ -105,6 +128,12 @@ private:
 	// callbacks
 	output_delegate         m_saved_error_output;
 	output_delegate         m_saved_warning_output;
+
+	// parallel state
+	validity_checker *      m_owner;            // owning checker, for workers
+	osd_lock *              m_checked_lock;     // guards m_already_checked during a parallel run
+	validity_checker *      m_workers[WORK_MAX_THREADS + 1]; // one per worker thread; the last also runs inline batches
+	astring                 m_deferred_text;    // report text held until written in driver order
 };
 
 #endif
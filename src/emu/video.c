@@ -285,6 +285,12 @@ astring &video_manager::speed_text(astring &string)
 	if (partials > 1)
 		string.catprintf("\n%d partial updates", partials);
 
+	// display the layout element texture hit rate, if there are any elements
+	UINT64 elemrequests = machine().render().element_requests();
+	UINT64 elemrenders = machine().render().element_renders();
+	if (elemrequests != 0)
+		string.catprintf("\n%d%% element cache hits", (elemrenders < elemrequests) ? (int)(100 * (elemrequests - elemrenders) / elemrequests) : 0);
+
 	return string;
 }
 
@@ -542,6 +548,11 @@ void video_manager::exit()
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds);
 	}
+
+	// report how many frames could have skipped the OSD redraw
+	for (render_target *target = machine().render().first_target(); target != NULL; target = target->next())
+		if (target->frames_built() != 0)
+			osd_printf_verbose("Render target %d: %d of %d frames unchanged\n", target->index(), target->frames_unchanged(), target->frames_built());
 }
 
 
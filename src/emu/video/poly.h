@@ -59,6 +59,7 @@
 #define POLYFLAG_INCLUDE_BOTTOM_EDGE        0x01
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
+#define POLYFLAG_TILE_BINNING               0x08        // defer work and dispatch one item per bucket at wait time
 
 #define SCANLINES_PER_BUCKET                8
 #define CACHE_LINE_SIZE                     64          // this is a general guess
@@ -249,6 +250,8 @@ private:
 	}
 
 	static void *work_item_callback(void *param, int threadid);
+	static void *bin_item_callback(void *param, int threadid) { return work_item_callback(*(work_unit **)param, threadid); }
+	void flush_bins();
 	void presave() { wait("pre-save"); }
 
 	// queue management
@@ -266,12 +269,14 @@ private:
 
 	// buckets
 	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	work_unit *         m_bin_list[TOTAL_BUCKETS];  // first unit of each non-empty bucket, in tile binning mode
 
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
 	UINT32              m_quads;                    // number of quads queued
 	UINT64              m_pixels;                   // number of pixels rendered
+	UINT32              m_bins;                     // number of bins dispatched
 #if KEEP_POLY_STATISTICS
 	UINT32              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
 	UINT32              m_resolved[WORK_MAX_THREADS];   // number of conflicts resolved, per thread
@@ -294,12 +299,14 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 		m_flags(flags),
 		m_triangles(0),
 		m_quads(0),
-		m_pixels(0)
+		m_pixels(0),
+		m_bins(0)
 {
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
 #endif
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
 
 	// create the work queue
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
@@ -321,12 +328,14 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 		m_flags(flags),
 		m_triangles(0),
 		m_quads(0),
-		m_pixels(0)
+		m_pixels(0),
+		m_bins(0)
 {
 #if KEEP_POLY_STATISTICS
 	memset(m_conflicts, 0, sizeof(m_conflicts));
 	memset(m_resolved, 0, sizeof(m_resolved));
 #endif
+	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
 
 	// create the work queue
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
@@ -363,6 +372,7 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 		printf("Total pixels   = %d\n", (UINT32)m_pixels);
 
 	printf("Conflicts:   %d resolved, %d total\n", resolved, conflicts);
+	printf("Bins:        %d dispatched\n", m_bins);
 	printf("Units:       %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_unit.max(), m_unit.allocated(), m_unit.waits(), m_unit.itemsize(), m_unit.allocated() * m_unit.itemsize());
 	printf("Polygons:    %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_polygon.max(), m_polygon.allocated(), m_polygon.waits(), m_polygon.itemsize(), m_polygon.allocated() * m_polygon.itemsize());
 	printf("Object data: %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_object.max(), m_object.allocated(), m_object.waits(), m_object.itemsize(), m_object.allocated() * m_object.itemsize());
@@ -437,6 +447,44 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 }
 
 
+//-------------------------------------------------
+//  flush_bins - in tile binning mode, chain the
+//  pending work units of each bucket together in
+//  submission order and queue one item per bucket
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::flush_bins()
+{
+	UINT16 head[TOTAL_BUCKETS], tail[TOTAL_BUCKETS];
+	int bucketnum, numbins = 0;
+
+	// link each unit to the next one in its bucket; index 0 can never be a
+	// successor, so it doubles as the end marker just like in the queued case
+	memset(tail, 0xff, sizeof(tail));
+	for (int unitnum = 0; unitnum < m_unit.count(); unitnum++)
+	{
+		work_unit &unit = m_unit[unitnum];
+		bucketnum = ((UINT32)unit.scanline / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		if (tail[bucketnum] != 0xffff)
+			m_unit[tail[bucketnum]].count_next |= unitnum << 16;
+		else
+			head[bucketnum] = unitnum;
+		tail[bucketnum] = unitnum;
+	}
+
+	// gather the heads; each bucket is then rendered start to finish by a
+	// single thread, so the result is independent of scheduling
+	for (bucketnum = 0; bucketnum < TOTAL_BUCKETS; bucketnum++)
+		if (tail[bucketnum] != 0xffff)
+			m_bin_list[numbins++] = &m_unit[head[bucketnum]];
+
+	if (numbins > 0)
+		osd_work_item_queue_multiple(m_queue, bin_item_callback, numbins, &m_bin_list[0], sizeof(m_bin_list[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	m_bins += numbins;
+}
+
+
 //-------------------------------------------------
 //  wait - stall until all work is complete
 //-------------------------------------------------
@@ -452,7 +500,11 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 
 	// wait for all pending work items to complete
 	if (m_queue != NULL)
+	{
+		if (m_flags & POLYFLAG_TILE_BINNING)
+			flush_bins();
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+	}
 
 	// if we don't have a queue, just run the whole list now
 	else
@@ -618,7 +670,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
+	if (m_queue != NULL && !(m_flags & POLYFLAG_TILE_BINNING))
 		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	// return the total number of pixels in the triangle
@@ -806,7 +858,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
+	if (m_queue != NULL && !(m_flags & POLYFLAG_TILE_BINNING))
 		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	// return the total number of pixels in the triangle
@@ -922,7 +974,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
+	if (m_queue != NULL && !(m_flags & POLYFLAG_TILE_BINNING))
 		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	// return the total number of pixels in the object
@@ -1121,7 +1173,7 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 	}
 
 	// enqueue the work items
-	if (m_queue != NULL)
+	if (m_queue != NULL && !(m_flags & POLYFLAG_TILE_BINNING))
 		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
 
 	// return the total number of pixels in the triangle
@@ -0,0 +1,153 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    voodblend.h
+
+    3dfx Voodoo Graphics SST-1/2 emulator.
+
+    Per-pixel colour arithmetic from the texture combine, fogging and
+    alpha blending stages. Each helper has a scalar form and an SSE2
+    form that handles all channels at once; the two must match bit for
+    bit, which src/tools/voodbench.c checks.
+
+    All of them scale terms by 8.8 factors, shift down, add and clamp
+    each channel to 8 bits. The terms are within +/-263 and the factors
+    within +/-320, so every product fits in 32 bits and the SSE2 forms
+    can build them from 16-bit multiplies.
+
+***************************************************************************/
+
+#ifndef __VOODBLEND_H__
+#define __VOODBLEND_H__
+
+#pragma once
+
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#include <emmintrin.h>
+#define VOODBLEND_SSE2
+#endif
+
+
+
+/*************************************
+ *
+ *  Scalar helpers
+ *
+ *************************************/
+
+INLINE INT32 voodblend_clamp8(INT32 value)
+{
+	return (value < 0) ? 0 : (value > 0xff) ? 0xff : value;
+}
+
+
+/*-------------------------------------------------
+    texture_blend_add_clamp_c - scale each texture
+    combine term by its blend factor, add the
+    local term and clamp
+-------------------------------------------------*/
+
+INLINE UINT32 texture_blend_add_clamp_c(INT32 tr, INT32 tg, INT32 tb, INT32 ta, INT32 blendr, INT32 blendg, INT32 blendb, INT32 blenda, INT32 addr, INT32 addg, INT32 addb, INT32 adda)
+{
+	tr = voodblend_clamp8(((tr * (blendr + 1)) >> 8) + addr);
+	tg = voodblend_clamp8(((tg * (blendg + 1)) >> 8) + addg);
+	tb = voodblend_clamp8(((tb * (blendb + 1)) >> 8) + addb);
+	ta = voodblend_clamp8(((ta * (blenda + 1)) >> 8) + adda);
+	return (ta << 24) | (tr << 16) | (tg << 8) | tb;
+}
+
+
+/*-------------------------------------------------
+    fog_blend_add_clamp_c - scale the fog terms by
+    the fog blend factor, add the incoming colour
+    and clamp; alpha is returned as 0
+-------------------------------------------------*/
+
+INLINE UINT32 fog_blend_add_clamp_c(INT32 fr, INT32 fg, INT32 fb, INT32 fogblend, INT32 addr, INT32 addg, INT32 addb)
+{
+	fr = voodblend_clamp8(((fr * fogblend) >> 8) + addr);
+	fg = voodblend_clamp8(((fg * fogblend) >> 8) + addg);
+	fb = voodblend_clamp8(((fb * fogblend) >> 8) + addb);
+	return (fr << 16) | (fg << 8) | fb;
+}
+
+
+/*-------------------------------------------------
+    alpha_blend_clamp_c - scale the source and
+    destination colours by their blend factors,
+    sum and clamp
+-------------------------------------------------*/
+
+INLINE UINT32 alpha_blend_clamp_c(INT32 sr, INT32 sg, INT32 sb, INT32 sa, INT32 ssr, INT32 ssg, INT32 ssb, INT32 ssa,
+		INT32 dr, INT32 dg, INT32 db, INT32 da, INT32 dsr, INT32 dsg, INT32 dsb, INT32 dsa)
+{
+	INT32 r = voodblend_clamp8(((sr * ssr) >> 8) + ((dr * dsr) >> 8));
+	INT32 g = voodblend_clamp8(((sg * ssg) >> 8) + ((dg * dsg) >> 8));
+	INT32 b = voodblend_clamp8(((sb * ssb) >> 8) + ((db * dsb) >> 8));
+	INT32 a = voodblend_clamp8(((sa * ssa) >> 8) + ((da * dsa) >> 8));
+	return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+
+
+/*************************************
+ *
+ *  SSE2 helpers
+ *
+ *************************************/
+
+#ifdef VOODBLEND_SSE2
+
+/*-------------------------------------------------
+    voodblend_scale - multiply four 16-bit terms
+    by four 16-bit factors into 32-bit products
+    and shift them down by 8
+-------------------------------------------------*/
+
+INLINE __m128i voodblend_scale(__m128i term, __m128i scale)
+{
+	return _mm_srai_epi32(_mm_unpacklo_epi16(_mm_mullo_epi16(term, scale), _mm_mulhi_epi16(term, scale)), 8);
+}
+
+
+/*-------------------------------------------------
+    voodblend_pack - clamp four 32-bit channels to
+    8 bits and pack them as ARGB
+-------------------------------------------------*/
+
+INLINE UINT32 voodblend_pack(__m128i result)
+{
+	result = _mm_packs_epi32(result, result);
+	result = _mm_packus_epi16(result, result);
+	return _mm_cvtsi128_si32(result);
+}
+
+
+INLINE UINT32 texture_blend_add_clamp_sse2(INT32 tr, INT32 tg, INT32 tb, INT32 ta, INT32 blendr, INT32 blendg, INT32 blendb, INT32 blenda, INT32 addr, INT32 addg, INT32 addb, INT32 adda)
+{
+	__m128i term = _mm_set_epi16(0, 0, 0, 0, ta, tr, tg, tb);
+	__m128i scale = _mm_set_epi16(0, 0, 0, 0, blenda + 1, blendr + 1, blendg + 1, blendb + 1);
+	return voodblend_pack(_mm_add_epi32(voodblend_scale(term, scale), _mm_set_epi32(adda, addr, addg, addb)));
+}
+
+
+INLINE UINT32 fog_blend_add_clamp_sse2(INT32 fr, INT32 fg, INT32 fb, INT32 fogblend, INT32 addr, INT32 addg, INT32 addb)
+{
+	__m128i term = _mm_set_epi16(0, 0, 0, 0, 0, fr, fg, fb);
+	__m128i scale = _mm_set1_epi16(fogblend);
+	return voodblend_pack(_mm_add_epi32(voodblend_scale(term, scale), _mm_set_epi32(0, addr, addg, addb)));
+}
+
+
+INLINE UINT32 alpha_blend_clamp_sse2(INT32 sr, INT32 sg, INT32 sb, INT32 sa, INT32 ssr, INT32 ssg, INT32 ssb, INT32 ssa,
+		INT32 dr, INT32 dg, INT32 db, INT32 da, INT32 dsr, INT32 dsg, INT32 dsb, INT32 dsa)
+{
+	__m128i source = voodblend_scale(_mm_set_epi16(0, 0, 0, 0, sa, sr, sg, sb), _mm_set_epi16(0, 0, 0, 0, ssa, ssr, ssg, ssb));
+	__m128i dest = voodblend_scale(_mm_set_epi16(0, 0, 0, 0, da, dr, dg, db), _mm_set_epi16(0, 0, 0, 0, dsa, dsr, dsg, dsb));
+	return voodblend_pack(_mm_add_epi32(source, dest));
+}
+
+#endif
+
+#endif  /* __VOODBLEND_H__ */
@@ -1395,6 +1395,7 @@ struct voodoo_stats
 	INT32               total_afunc_fail;       /* total a func fail */
 	INT32               total_clipped;          /* total clipped */
 	INT32               total_stippled;         /* total stippled */
+	INT32               total_generic;          /* total pixels sent to the generic rasterizers */
 	INT32               lfb_writes;             /* LFB writes */
 	INT32               lfb_reads;              /* LFB reads */
 	INT32               reg_writes;             /* register writes */
@@ -1967,6 +1968,27 @@ INLINE INT64 float_to_int64(UINT32 data, int fixedbits)
 
 
 
+/*************************************
+ *
+ *  Colour arithmetic helpers
+ *
+ *  Use the SSE2 forms from voodblend.h
+ *  whenever rgbutil.h uses SSE2.
+ *
+ *************************************/
+
+#ifdef __RGBSSE__
+#define texture_blend_add_clamp     texture_blend_add_clamp_sse2
+#define fog_blend_add_clamp         fog_blend_add_clamp_sse2
+#define alpha_blend_clamp           alpha_blend_clamp_sse2
+#else
+#define texture_blend_add_clamp     texture_blend_add_clamp_c
+#define fog_blend_add_clamp         fog_blend_add_clamp_c
+#define alpha_blend_clamp           alpha_blend_clamp_c
+#endif
+
+
+
 /*************************************
  *
  *  Rasterizer inlines
@@ -2428,7 +2450,9 @@ do
 		int sg = (GG);                                                          \
 		int sb = (BB);                                                          \
 		int sa = (AA);                                                          \
+		int ssr, ssg, ssb, dsr, dsg, dsb;                                       \
 		int ta;                                                                 \
+		UINT32 blended;                                                         \
 																				\
 		/* apply dither subtraction */                                          \
 		if (FBZMODE_ALPHA_DITHER_SUBTRACT(FBZMODE))                             \
@@ -2442,131 +2466,108 @@ do
 			db = ((db << 1) + 15 - dith) >> 1;                                  \
 		}                                                                       \
 																				\
-		/* compute source portion */                                            \
+		/* compute source blend factors */                                      \
 		switch (ALPHAMODE_SRCRGBBLEND(ALPHAMODE))                               \
 		{                                                                       \
 			default:    /* reserved */                                          \
 			case 0:     /* AZERO */                                             \
-				(RR) = (GG) = (BB) = 0;                                         \
+				ssr = ssg = ssb = 0;                                            \
 				break;                                                          \
 																				\
 			case 1:     /* ASRC_ALPHA */                                        \
-				(RR) = (sr * (sa + 1)) >> 8;                                    \
-				(GG) = (sg * (sa + 1)) >> 8;                                    \
-				(BB) = (sb * (sa + 1)) >> 8;                                    \
+				ssr = ssg = ssb = sa + 1;                                       \
 				break;                                                          \
 																				\
 			case 2:     /* A_COLOR */                                           \
-				(RR) = (sr * (dr + 1)) >> 8;                                    \
-				(GG) = (sg * (dg + 1)) >> 8;                                    \
-				(BB) = (sb * (db + 1)) >> 8;                                    \
+				ssr = dr + 1;                                                   \
+				ssg = dg + 1;                                                   \
+				ssb = db + 1;                                                   \
 				break;                                                          \
 																				\
 			case 3:     /* ADST_ALPHA */                                        \
-				(RR) = (sr * (da + 1)) >> 8;                                    \
-				(GG) = (sg * (da + 1)) >> 8;                                    \
-				(BB) = (sb * (da + 1)) >> 8;                                    \
+				ssr = ssg = ssb = da + 1;                                       \
 				break;                                                          \
 																				\
 			case 4:     /* AONE */                                              \
+				ssr = ssg = ssb = 0x100;                                        \
 				break;                                                          \
 																				\
 			case 5:     /* AOMSRC_ALPHA */                                      \
-				(RR) = (sr * (0x100 - sa)) >> 8;                                \
-				(GG) = (sg * (0x100 - sa)) >> 8;                                \
-				(BB) = (sb * (0x100 - sa)) >> 8;                                \
+				ssr = ssg = ssb = 0x100 - sa;                                   \
 				break;                                                          \
 																				\
 			case 6:     /* AOM_COLOR */                                         \
-				(RR) = (sr * (0x100 - dr)) >> 8;                                \
-				(GG) = (sg * (0x100 - dg)) >> 8;                                \
-				(BB) = (sb * (0x100 - db)) >> 8;                                \
+				ssr = 0x100 - dr;                                               \
+				ssg = 0x100 - dg;                                               \
+				ssb = 0x100 - db;                                               \
 				break;                                                          \
 																				\
 			case 7:     /* AOMDST_ALPHA */                                      \
-				(RR) = (sr * (0x100 - da)) >> 8;                                \
-				(GG) = (sg * (0x100 - da)) >> 8;                                \
-				(BB) = (sb * (0x100 - da)) >> 8;                                \
+				ssr = ssg = ssb = 0x100 - da;                                   \
 				break;                                                          \
 																				\
 			case 15:    /* ASATURATE */                                         \
 				ta = (sa < (0x100 - da)) ? sa : (0x100 - da);                   \
-				(RR) = (sr * (ta + 1)) >> 8;                                    \
-				(GG) = (sg * (ta + 1)) >> 8;                                    \
-				(BB) = (sb * (ta + 1)) >> 8;                                    \
+				ssr = ssg = ssb = ta + 1;                                       \
 				break;                                                          \
 		}                                                                       \
 																				\
-		/* add in dest portion */                                               \
+		/* compute dest blend factors */                                        \
 		switch (ALPHAMODE_DSTRGBBLEND(ALPHAMODE))                               \
 		{                                                                       \
 			default:    /* reserved */                                          \
 			case 0:     /* AZERO */                                             \
+				dsr = dsg = dsb = 0;                                            \
 				break;                                                          \
 																				\
 			case 1:     /* ASRC_ALPHA */                                        \
-				(RR) += (dr * (sa + 1)) >> 8;                                   \
-				(GG) += (dg * (sa + 1)) >> 8;                                   \
-				(BB) += (db * (sa + 1)) >> 8;                                   \
+				dsr = dsg = dsb = sa + 1;                                       \
 				break;                                                          \
 																				\
 			case 2:     /* A_COLOR */                                           \
-				(RR) += (dr * (sr + 1)) >> 8;                                   \
-				(GG) += (dg * (sg + 1)) >> 8;                                   \
-				(BB) += (db * (sb + 1)) >> 8;                                   \
+				dsr = sr + 1;                                                   \
+				dsg = sg + 1;                                                   \
+				dsb = sb + 1;                                                   \
 				break;                                                          \
 																				\
 			case 3:     /* ADST_ALPHA */                                        \
-				(RR) += (dr * (da + 1)) >> 8;                                   \
-				(GG) += (dg * (da + 1)) >> 8;                                   \
-				(BB) += (db * (da + 1)) >> 8;                                   \
+				dsr = dsg = dsb = da + 1;                                       \
 				break;                                                          \
 																				\
 			case 4:     /* AONE */                                              \
-				(RR) += dr;                                                     \
-				(GG) += dg;                                                     \
-				(BB) += db;                                                     \
+				dsr = dsg = dsb = 0x100;                                        \
 				break;                                                          \
 																				\
 			case 5:     /* AOMSRC_ALPHA */                                      \
-				(RR) += (dr * (0x100 - sa)) >> 8;                               \
-				(GG) += (dg * (0x100 - sa)) >> 8;                               \
-				(BB) += (db * (0x100 - sa)) >> 8;                               \
+				dsr = dsg = dsb = 0x100 - sa;                                   \
 				break;                                                          \
 																				\
 			case 6:     /* AOM_COLOR */                                         \
-				(RR) += (dr * (0x100 - sr)) >> 8;                               \
-				(GG) += (dg * (0x100 - sg)) >> 8;                               \
-				(BB) += (db * (0x100 - sb)) >> 8;                               \
+				dsr = 0x100 - sr;                                               \
+				dsg = 0x100 - sg;                                               \
+				dsb = 0x100 - sb;                                               \
 				break;                                                          \
 																				\
 			case 7:     /* AOMDST_ALPHA */                                      \
-				(RR) += (dr * (0x100 - da)) >> 8;                               \
-				(GG) += (dg * (0x100 - da)) >> 8;                               \
-				(BB) += (db * (0x100 - da)) >> 8;                               \
+				dsr = dsg = dsb = 0x100 - da;                                   \
 				break;                                                          \
 																				\
 			case 15:    /* A_COLORBEFOREFOG */                                  \
-				(RR) += (dr * (prefogr + 1)) >> 8;                              \
-				(GG) += (dg * (prefogg + 1)) >> 8;                              \
-				(BB) += (db * (prefogb + 1)) >> 8;                              \
+				dsr = prefogr + 1;                                              \
+				dsg = prefogg + 1;                                              \
+				dsb = prefogb + 1;                                              \
 				break;                                                          \
 		}                                                                       \
 																				\
-		/* blend the source alpha */                                            \
-		(AA) = 0;                                                               \
-		if (ALPHAMODE_SRCALPHABLEND(ALPHAMODE) == 4)                            \
-			(AA) = sa;                                                          \
-																				\
-		/* blend the dest alpha */                                              \
-		if (ALPHAMODE_DSTALPHABLEND(ALPHAMODE) == 4)                            \
-			(AA) += da;                                                         \
-																				\
-		/* clamp */                                                             \
-		CLAMP((RR), 0x00, 0xff);                                                \
-		CLAMP((GG), 0x00, 0xff);                                                \
-		CLAMP((BB), 0x00, 0xff);                                                \
-		CLAMP((AA), 0x00, 0xff);                                                \
+		/* blend and clamp; alpha is the sum of the source and/or dest alpha */ \
+		blended = alpha_blend_clamp(sr, sg, sb, sa, ssr, ssg, ssb,              \
+					(ALPHAMODE_SRCALPHABLEND(ALPHAMODE) == 4) ? 0x100 : 0,      \
+					dr, dg, db, da, dsr, dsg, dsb,                              \
+					(ALPHAMODE_DSTALPHABLEND(ALPHAMODE) == 4) ? 0x100 : 0);     \
+		(RR) = (blended >> 16) & 0xff;                                          \
+		(GG) = (blended >> 8) & 0xff;                                           \
+		(BB) = blended & 0xff;                                                  \
+		(AA) = blended >> 24;                                                   \
 	}                                                                           \
 }                                                                               \
 while (0)
@@ -2586,6 +2587,8 @@ do
 	{                                                                           \
 		rgb_union fogcolor = (VV)->reg[fogColor];                               \
 		INT32 fr, fg, fb;                                                       \
+		INT32 fogblend = 0x100;                                                 \
+		UINT32 fogged;                                                          \
 																				\
 		/* constant fog bypasses everything else */                             \
 		if (FOGMODE_FOG_CONSTANT(FOGMODE))                                      \
@@ -2598,8 +2601,6 @@ do
 		/* non-constant fog comes from several sources */                       \
 		else                                                                    \
 		{                                                                       \
-			INT32 fogblend = 0;                                                 \
-																				\
 			/* if fog_add is zero, we start with the fog color */               \
 			if (FOGMODE_FOG_ADD(FOGMODE) == 0)                                  \
 			{                                                                   \
@@ -2659,33 +2660,20 @@ do
 					break;                                                      \
 			}                                                                   \
 																				\
-			/* perform the blend */                                             \
+			/* the blend factor is one more than the fog value */               \
 			fogblend++;                                                         \
-			fr = (fr * fogblend) >> 8;                                          \
-			fg = (fg * fogblend) >> 8;                                          \
-			fb = (fb * fogblend) >> 8;                                          \
 		}                                                                       \
 																				\
-		/* if fog_mult is 0, we add this to the original color */               \
+		/* perform the blend; if fog_mult is 0, we add this to the original */  \
+		/* color, otherwise this just becomes the new color */                  \
 		if (FOGMODE_FOG_MULT(FOGMODE) == 0)                                     \
-		{                                                                       \
-			(RR) += fr;                                                         \
-			(GG) += fg;                                                         \
-			(BB) += fb;                                                         \
-		}                                                                       \
-																				\
-		/* otherwise this just becomes the new color */                         \
+			fogged = fog_blend_add_clamp(fr, fg, fb, fogblend,                  \
+					(RR), (GG), (BB));                                          \
 		else                                                                    \
-		{                                                                       \
-			(RR) = fr;                                                          \
-			(GG) = fg;                                                          \
-			(BB) = fb;                                                          \
-		}                                                                       \
-																				\
-		/* clamp */                                                             \
-		CLAMP((RR), 0x00, 0xff);                                                \
-		CLAMP((GG), 0x00, 0xff);                                                \
-		CLAMP((BB), 0x00, 0xff);                                                \
+			fogged = fog_blend_add_clamp(fr, fg, fb, fogblend, 0, 0, 0);        \
+		(RR) = (fogged >> 16) & 0xff;                                           \
+		(GG) = (fogged >> 8) & 0xff;                                            \
+		(BB) = fogged & 0xff;                                                   \
 	}                                                                           \
 }                                                                               \
 while (0)
@@ -2702,6 +2690,7 @@ while (0)
 do                                                                              \
 {                                                                               \
 	INT32 blendr, blendg, blendb, blenda;                                       \
+	INT32 addr, addg, addb, adda;                                               \
 	INT32 tr, tg, tb, ta;                                                       \
 	INT32 oow, s, t, lod, ilod;                                                 \
 	INT32 smax, tmax;                                                           \
@@ -2985,41 +2974,31 @@ do
 	if (!TEXMODE_TCA_REVERSE_BLEND(TEXMODE))                                    \
 		blenda ^= 0xff;                                                         \
 																				\
-	/* do the blend */                                                          \
-	tr = (tr * (blendr + 1)) >> 8;                                              \
-	tg = (tg * (blendg + 1)) >> 8;                                              \
-	tb = (tb * (blendb + 1)) >> 8;                                              \
-	ta = (ta * (blenda + 1)) >> 8;                                              \
-																				\
 	/* add clocal or alocal to RGB */                                           \
 	switch (TEXMODE_TC_ADD_ACLOCAL(TEXMODE))                                    \
 	{                                                                           \
 		case 3:     /* reserved */                                              \
 		case 0:     /* nothing */                                               \
+			addr = addg = addb = 0;                                             \
 			break;                                                              \
 																				\
 		case 1:     /* add c_local */                                           \
-			tr += c_local.rgb.r;                                                \
-			tg += c_local.rgb.g;                                                \
-			tb += c_local.rgb.b;                                                \
+			addr = c_local.rgb.r;                                               \
+			addg = c_local.rgb.g;                                               \
+			addb = c_local.rgb.b;                                               \
 			break;                                                              \
 																				\
 		case 2:     /* add_alocal */                                            \
-			tr += c_local.rgb.a;                                                \
-			tg += c_local.rgb.a;                                                \
-			tb += c_local.rgb.a;                                                \
+			addr = addg = addb = c_local.rgb.a;                                 \
 			break;                                                              \
 	}                                                                           \
 																				\
 	/* add clocal or alocal to alpha */                                         \
-	if (TEXMODE_TCA_ADD_ACLOCAL(TEXMODE))                                       \
-		ta += c_local.rgb.a;                                                    \
+	adda = TEXMODE_TCA_ADD_ACLOCAL(TEXMODE) ? c_local.rgb.a : 0;                \
 																				\
-	/* clamp */                                                                 \
-	RESULT.rgb.r = (tr < 0) ? 0 : (tr > 0xff) ? 0xff : tr;                      \
-	RESULT.rgb.g = (tg < 0) ? 0 : (tg > 0xff) ? 0xff : tg;                      \
-	RESULT.rgb.b = (tb < 0) ? 0 : (tb > 0xff) ? 0xff : tb;                      \
-	RESULT.rgb.a = (ta < 0) ? 0 : (ta > 0xff) ? 0xff : ta;                      \
+	/* do the blend, add and clamp */                                           \
+	RESULT.u = texture_blend_add_clamp(tr, tg, tb, ta,                          \
+					blendr, blendg, blendb, blenda, addr, addg, addb, adda);    \
 																				\
 	/* invert */                                                                \
 	if (TEXMODE_TC_INVERT_OUTPUT(TEXMODE))                                      \
@@ -3560,16 +3539,25 @@ static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, co
 	INT32 scry;                                                                 \
 	INT32 x;                                                                    \
 																				\
+	/* latch the mode words; constant in the precompiled rasterizers, */        \
+	/* and read once per span instead of per pixel in the generic ones */       \
+	const UINT32 r_colorpath = FBZCOLORPATH;                                    \
+	const UINT32 r_fbzmode = FBZMODE;                                           \
+	const UINT32 r_alphamode = ALPHAMODE;                                       \
+	const UINT32 r_fogmode = FOGMODE;                                           \
+	const UINT32 r_texmode0 = TEXMODE0;                                         \
+	const UINT32 r_texmode1 = TEXMODE1;                                         \
+																				\
 	/* determine the screen Y */                                                \
 	scry = y;                                                                   \
-	if (FBZMODE_Y_ORIGIN(FBZMODE))                                              \
+	if (FBZMODE_Y_ORIGIN(r_fbzmode))                                            \
 		scry = (v->fbi.yorigin - y) & 0x3ff;                                    \
 																				\
 	/* compute dithering */                                                     \
-	COMPUTE_DITHER_POINTERS(FBZMODE, y);                                        \
+	COMPUTE_DITHER_POINTERS(r_fbzmode, y);                                      \
 																				\
 	/* apply clipping */                                                        \
-	if (FBZMODE_ENABLE_CLIPPING(FBZMODE))                                       \
+	if (FBZMODE_ENABLE_CLIPPING(r_fbzmode))                                     \
 	{                                                                           \
 		INT32 tempclip;                                                         \
 																				\
@@ -3632,13 +3620,13 @@ static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, co
 		rgb_union texel = { 0 };                                                \
 																				\
 		/* pixel pipeline part 1 handles depth testing and stippling */         \
-		PIXEL_PIPELINE_BEGIN(v, stats, x, y, FBZCOLORPATH, FBZMODE,             \
+		PIXEL_PIPELINE_BEGIN(v, stats, x, y, r_colorpath, r_fbzmode,            \
 								iterz, iterw);                                  \
 																				\
 		/* run the texture pipeline on TMU1 to produce a value in texel */      \
 		/* note that they set LOD min to 8 to "disable" a TMU */                \
 		if (TMUS >= 2 && v->tmu[1].lodmin < (8 << 8))                           \
-			TEXTURE_PIPELINE(&v->tmu[1], x, dither4, TEXMODE1, texel,           \
+			TEXTURE_PIPELINE(&v->tmu[1], x, dither4, r_texmode1, texel,         \
 								v->tmu[1].lookup, extra->lodbase1,              \
 								iters1, itert1, iterw1, texel);                 \
 																				\
@@ -3649,7 +3637,7 @@ static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, co
 				{                                                                   \
 			if (!v->send_config)                                                \
 						{                                                                   \
-				TEXTURE_PIPELINE(&v->tmu[0], x, dither4, TEXMODE0, texel,           \
+				TEXTURE_PIPELINE(&v->tmu[0], x, dither4, r_texmode0, texel,         \
 									v->tmu[0].lookup, extra->lodbase0,              \
 									iters0, itert0, iterw0, texel);                 \
 						}                                                                   \
@@ -3660,13 +3648,13 @@ static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, co
 				}                                                                   \
 																				\
 		/* colorpath pipeline selects source colors and does blending */        \
-		CLAMPED_ARGB(iterr, iterg, iterb, itera, FBZCOLORPATH, iterargb);       \
-		COLORPATH_PIPELINE(v, stats, FBZCOLORPATH, FBZMODE, ALPHAMODE, texel,   \
+		CLAMPED_ARGB(iterr, iterg, iterb, itera, r_colorpath, iterargb);        \
+		COLORPATH_PIPELINE(v, stats, r_colorpath, r_fbzmode, r_alphamode, texel, \
 							iterz, iterw, iterargb);                            \
 																				\
 		/* pixel pipeline part 2 handles fog, alpha, and final output */        \
 		PIXEL_PIPELINE_END(v, stats, dither, dither4, dither_lookup, x, dest, depth, \
-							FBZMODE, FBZCOLORPATH, ALPHAMODE, FOGMODE,          \
+							r_fbzmode, r_colorpath, r_alphamode, r_fogmode,     \
 							iterz, iterw, iterargb);                            \
 																				\
 		/* update the iterated parameters */                                    \
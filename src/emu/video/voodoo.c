@@ -148,6 +148,7 @@ bits(7:4) and bit(24)), X, and Y:
 #include "video/polylgcy.h"
 #include "video/rgbutil.h"
 #include "voodoo.h"
+#include "voodblend.h"
 #include "vooddefs.h"
 
 
@@ -233,9 +234,7 @@ static void dump_rasterizer_stats(voodoo_state *v);
 
 /* generic rasterizers */
 static void raster_fastfill(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+static poly_draw_scanline_func generic_rasterizer(const raster_info *info, int texcount);
 
 
 
@@ -916,6 +915,7 @@ static void swap_buffers(voodoo_state *v)
 		statsptr += sprintf(statsptr, "POut:%6d\n", v->stats.total_pixels_out);
 		statsptr += sprintf(statsptr, "Clip:%6d\n", v->stats.total_clipped);
 		statsptr += sprintf(statsptr, "Stip:%6d\n", v->stats.total_stippled);
+		statsptr += sprintf(statsptr, "Gnrc:%6d\n", v->stats.total_generic);
 		statsptr += sprintf(statsptr, "Chro:%6d\n", v->stats.total_chroma_fail);
 		statsptr += sprintf(statsptr, "ZFun:%6d\n", v->stats.total_zfunc_fail);
 		statsptr += sprintf(statsptr, "AFun:%6d\n", v->stats.total_afunc_fail);
@@ -941,6 +941,7 @@ static void swap_buffers(voodoo_state *v)
 	v->stats.total_afunc_fail = 0;
 	v->stats.total_clipped = 0;
 	v->stats.total_stippled = 0;
+	v->stats.total_generic = 0;
 	v->stats.reg_writes = 0;
 	v->stats.reg_reads = 0;
 	v->stats.lfb_writes = 0;
@@ -5460,6 +5461,7 @@ static INT32 triangle_create_work_item(voodoo_state *v, UINT16 *drawbuf, int tex
 	poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(v->poly);
 	raster_info *info = find_rasterizer(v, texcount);
 	poly_vertex vert[3];
+	INT32 pixels;
 
 	/* fill in the vertex data */
 	vert[0].x = (float)v->fbi.ax * (1.0f / 16.0f);
@@ -5528,8 +5530,12 @@ static INT32 triangle_create_work_item(voodoo_state *v, UINT16 *drawbuf, int tex
 	}
 
 	/* farm the rasterization out to other threads */
+	pixels = poly_render_triangle(v->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
 	info->polys++;
-	return poly_render_triangle(v->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
+	info->hits += pixels;
+	if (info->is_generic)
+		v->stats.total_generic += pixels;
+	return pixels;
 }
 
 
@@ -5616,7 +5622,7 @@ static raster_info *find_rasterizer(voodoo_state *v, int texcount)
 		}
 
 	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	curinfo.callback = generic_rasterizer(&curinfo, texcount);
 	curinfo.is_generic = TRUE;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -5856,27 +5862,80 @@ static void raster_fastfill(void *destbase, INT32 y, const poly_extent *extent,
 
 
 /*-------------------------------------------------
-    generic_0tmu - generic rasterizer for 0 TMUs
+    generic rasterizers - one per TMU count and
+    combination of the features that gate the
+    largest parts of the pixel pipeline; the
+    feature enables (and, when a feature is off,
+    the bits it would use) are constants, so the
+    compiler drops the unused pipeline stages,
+    while the remaining mode bits are still read
+    from the live registers
 -------------------------------------------------*/
 
-RASTERIZER(generic_0tmu, 0, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, 0, 0)
-
-
-/*-------------------------------------------------
-    generic_1tmu - generic rasterizer for 1 TMU
--------------------------------------------------*/
-
-RASTERIZER(generic_1tmu, 1, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, 0)
+#define GENERIC_FEATURE_DEPTH       0x01        /* fbzMode depth buffering */
+#define GENERIC_FEATURE_BLEND       0x02        /* alphaMode alpha blending */
+#define GENERIC_FEATURE_FOG         0x04        /* fogMode fogging */
+#define GENERIC_FEATURE_ATEST       0x08        /* alphaMode alpha testing */
+
+#define GENERIC_FBZMODE(feat) \
+	(((feat) & GENERIC_FEATURE_DEPTH) ? (v->reg[fbzMode].u | 0x10) : (v->reg[fbzMode].u & ~0x10))
+#define GENERIC_ALPHAMODE(feat) \
+	((v->reg[alphaMode].u & ~(((feat) & GENERIC_FEATURE_ATEST) ? 0 : 0x0000000f) & ~(((feat) & GENERIC_FEATURE_BLEND) ? 0 : 0x00ffff10)) | \
+		(((feat) & GENERIC_FEATURE_ATEST) ? 0x01 : 0) | (((feat) & GENERIC_FEATURE_BLEND) ? 0x10 : 0))
+#define GENERIC_FOGMODE(feat) \
+	(((feat) & GENERIC_FEATURE_FOG) ? (v->reg[fogMode].u | 0x01) : 0)
+
+#define GENERIC_RASTERIZER(tmus, feat, texmode0, texmode1) \
+	RASTERIZER(generic_##tmus##tmu_##feat, tmus, v->reg[fbzColorPath].u, GENERIC_FBZMODE(feat), \
+				GENERIC_ALPHAMODE(feat), GENERIC_FOGMODE(feat), texmode0, texmode1)
+
+#define GENERIC_RASTERIZER_SET(tmus, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 0, texmode0, texmode1)  GENERIC_RASTERIZER(tmus, 1, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 2, texmode0, texmode1)  GENERIC_RASTERIZER(tmus, 3, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 4, texmode0, texmode1)  GENERIC_RASTERIZER(tmus, 5, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 6, texmode0, texmode1)  GENERIC_RASTERIZER(tmus, 7, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 8, texmode0, texmode1)  GENERIC_RASTERIZER(tmus, 9, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 10, texmode0, texmode1) GENERIC_RASTERIZER(tmus, 11, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 12, texmode0, texmode1) GENERIC_RASTERIZER(tmus, 13, texmode0, texmode1) \
+	GENERIC_RASTERIZER(tmus, 14, texmode0, texmode1) GENERIC_RASTERIZER(tmus, 15, texmode0, texmode1)
+
+GENERIC_RASTERIZER_SET(0, 0, 0)
+GENERIC_RASTERIZER_SET(1, v->tmu[0].reg[textureMode].u, 0)
+GENERIC_RASTERIZER_SET(2, v->tmu[0].reg[textureMode].u, v->tmu[1].reg[textureMode].u)
+
+#define GENERIC_RASTERIZER_LIST(tmus) { \
+	raster_generic_##tmus##tmu_0,  raster_generic_##tmus##tmu_1,  raster_generic_##tmus##tmu_2,  raster_generic_##tmus##tmu_3, \
+	raster_generic_##tmus##tmu_4,  raster_generic_##tmus##tmu_5,  raster_generic_##tmus##tmu_6,  raster_generic_##tmus##tmu_7, \
+	raster_generic_##tmus##tmu_8,  raster_generic_##tmus##tmu_9,  raster_generic_##tmus##tmu_10, raster_generic_##tmus##tmu_11, \
+	raster_generic_##tmus##tmu_12, raster_generic_##tmus##tmu_13, raster_generic_##tmus##tmu_14, raster_generic_##tmus##tmu_15 }
+
+static const poly_draw_scanline_func generic_raster_table[3][16] =
+{
+	GENERIC_RASTERIZER_LIST(0),
+	GENERIC_RASTERIZER_LIST(1),
+	GENERIC_RASTERIZER_LIST(2)
+};
 
 
 /*-------------------------------------------------
-    generic_2tmu - generic rasterizer for 2 TMUs
+    generic_rasterizer - pick the generic
+    rasterizer specialized for the features a
+    set of normalized modes enables
 -------------------------------------------------*/
 
-RASTERIZER(generic_2tmu, 2, v->reg[fbzColorPath].u, v->reg[fbzMode].u, v->reg[alphaMode].u,
-			v->reg[fogMode].u, v->tmu[0].reg[textureMode].u, v->tmu[1].reg[textureMode].u)
+static poly_draw_scanline_func generic_rasterizer(const raster_info *info, int texcount)
+{
+	int features = 0;
+	if (FBZMODE_ENABLE_DEPTHBUF(info->eff_fbz_mode))
+		features |= GENERIC_FEATURE_DEPTH;
+	if (ALPHAMODE_ALPHABLEND(info->eff_alpha_mode))
+		features |= GENERIC_FEATURE_BLEND;
+	if (FOGMODE_ENABLE_FOG(info->eff_fog_mode))
+		features |= GENERIC_FEATURE_FOG;
+	if (ALPHAMODE_ALPHATEST(info->eff_alpha_mode))
+		features |= GENERIC_FEATURE_ATEST;
+	return generic_raster_table[texcount][features];
+}
 
 
 #else
@@ -682,6 +682,22 @@ const void *core_fbuffer(core_file *file)
 }
 
 
+/*-------------------------------------------------
+    core_fmap - map the full file data into
+    memory copy-on-write; the mapping belongs to
+    the caller and outlives the file
+-------------------------------------------------*/
+
+file_error core_fmap(core_file *file, void **base)
+{
+	/* only uncompressed files still on disk can be mapped */
+	if (file->file == NULL || file->zdata != NULL || file->length == 0 || file->length > 0xffffffff)
+		return FILERR_FAILURE;
+
+	return osd_map(file->file, 0, file->length, base);
+}
+
+
 /*-------------------------------------------------
     core_fload - open a file with the specified
     filename, read it into memory, and return a
@@ -11,6 +11,21 @@
 #include "hashing.h"
 #include <zlib.h>
 
+// the PCLMULQDQ CRC-32 needs a compiler that can target it per function,
+// since the rest of the build may not assume the instruction exists
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || (defined(_MSC_VER) && _MSC_VER >= 1900))
+#define HASHING_CRC32_PCLMUL    1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define PCLMUL_TARGET
+#else
+#include <cpuid.h>
+#define PCLMUL_TARGET           __attribute__((target("pclmul")))
+#endif
+#endif
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -179,10 +194,111 @@ const char *crc32_t::as_string(astring &buffer) const
 
 void crc32_creator::append(const void *data, UINT32 length)
 {
+#ifdef HASHING_CRC32_PCLMUL
+	// fold whole 16-byte blocks with carry-less multiplies, leaving the tail to zlib
+	if (length >= 64 && crc32_have_pclmul())
+	{
+		UINT32 blocklength = length & ~15;
+		m_accum.m_raw = ~crc32_pclmul(reinterpret_cast<const UINT8 *>(data), blocklength, ~m_accum.m_raw);
+		data = reinterpret_cast<const UINT8 *>(data) + blocklength;
+		length -= blocklength;
+	}
+#endif
 	m_accum.m_raw = crc32(m_accum, reinterpret_cast<const Bytef *>(data), length);
 }
 
 
+#ifdef HASHING_CRC32_PCLMUL
+
+//-------------------------------------------------
+//  crc32_have_pclmul - return true if the CPU
+//  supports PCLMULQDQ
+//-------------------------------------------------
+
+bool crc32_creator::crc32_have_pclmul()
+{
+	// racing threads all compute the same answer
+	static int s_have_pclmul = -1;
+	if (s_have_pclmul == -1)
+	{
+#ifdef _MSC_VER
+		int regs[4];
+		__cpuid(regs, 1);
+		s_have_pclmul = (regs[2] >> 1) & 1;
+#else
+		unsigned int eax, ebx, ecx, edx;
+		s_have_pclmul = __get_cpuid(1, &eax, &ebx, &ecx, &edx) ? ((ecx >> 1) & 1) : 0;
+#endif
+	}
+	return (s_have_pclmul != 0);
+}
+
+
+//-------------------------------------------------
+//  crc32_pclmul - compute the raw (unconditioned)
+//  CRC-32 of a buffer of at least 64 bytes, a
+//  multiple of 16 long, by folding four 128-bit
+//  lanes with PCLMULQDQ and reducing the result
+//  with Barrett reduction; constants are those
+//  for the reflected zlib polynomial from Intel's
+//  "Fast CRC Computation for Generic Polynomials
+//  Using PCLMULQDQ Instruction"
+//-------------------------------------------------
+
+PCLMUL_TARGET UINT32 crc32_creator::crc32_pclmul(const UINT8 *data, UINT32 length, UINT32 crc)
+{
+	const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+	const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+	const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+	const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+	const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+	// load the first 64 bytes, folding in the incoming CRC
+	__m128i x1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00)), _mm_cvtsi32_si128(crc));
+	__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10));
+	__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20));
+	__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30));
+	data += 64;
+	length -= 64;
+
+	// fold 64 bytes at a time into the four lanes
+	while (length >= 64)
+	{
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k1k2, 0x00), _mm_clmulepi64_si128(x1, k1k2, 0x11)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, k1k2, 0x00), _mm_clmulepi64_si128(x2, k1k2, 0x11)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, k1k2, 0x00), _mm_clmulepi64_si128(x3, k1k2, 0x11)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, k1k2, 0x00), _mm_clmulepi64_si128(x4, k1k2, 0x11)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 0x30)));
+		data += 64;
+		length -= 64;
+	}
+
+	// fold the four lanes into one
+	x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x00), _mm_clmulepi64_si128(x1, k3k4, 0x11)), x2);
+	x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x00), _mm_clmulepi64_si128(x1, k3k4, 0x11)), x3);
+	x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x00), _mm_clmulepi64_si128(x1, k3k4, 0x11)), x4);
+
+	// fold any remaining 16-byte blocks
+	while (length >= 16)
+	{
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x00), _mm_clmulepi64_si128(x1, k3k4, 0x11)), _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+		data += 16;
+		length -= 16;
+	}
+
+	// fold 128 bits down to 64
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), _mm_clmulepi64_si128(x1, k3k4, 0x10));
+	x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k5k0, 0x00), _mm_srli_si128(x1, 4));
+
+	// Barrett reduce to 32 bits
+	__m128i x2r = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), poly, 0x10);
+	x2r = _mm_clmulepi64_si128(_mm_and_si128(x2r, mask32), poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2r);
+	return _mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+#endif
+
+
 
 //**************************************************************************
 //  CRC-16 HELPERS
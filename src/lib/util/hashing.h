@@ -165,6 +165,10 @@ public:
 	}
 
 protected:
+	// accelerated paths
+	static bool crc32_have_pclmul();
+	static UINT32 crc32_pclmul(const UINT8 *data, UINT32 length, UINT32 crc);
+
 	// internal state
 	crc32_t             m_accum;        // internal accumulator
 };
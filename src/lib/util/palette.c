@@ -36,6 +36,28 @@ inline rgb_t palette_t::adjust_palette_entry(rgb_t entry, float brightness, floa
 }
 
 
+//-------------------------------------------------
+//  adjusted_color - compute the adjusted value
+//  of an entry within a group, using the group's
+//  lookup table when the entry's own contrast is
+//  neutral
+//-------------------------------------------------
+
+inline rgb_t palette_t::adjusted_color(UINT32 group, UINT32 index)
+{
+	rgb_t entry = m_entry_color[index];
+	if (m_entry_contrast[index] == 1.0f)
+	{
+		const UINT8 *lut = &m_group_lut[group * 256];
+		return rgb_t(entry.a(), lut[entry.r()], lut[entry.g()], lut[entry.b()]);
+	}
+	return adjust_palette_entry(entry,
+								m_group_bright[group] + m_brightness,
+								m_group_contrast[group] * m_entry_contrast[index] * m_contrast,
+								m_gamma_map);
+}
+
+
 
 //**************************************************************************
 //  CLIENT DIRTY LIST MANAGEMENT
@@ -100,6 +122,30 @@ void palette_client::dirty_state::mark_dirty(UINT32 index)
 }
 
 
+//-------------------------------------------------
+//  mark_dirty_range - mark a range of entries
+//  dirty, inclusive
+//-------------------------------------------------
+
+void palette_client::dirty_state::mark_dirty_range(UINT32 start, UINT32 end)
+{
+	UINT32 firstword = start / 32, lastword = end / 32;
+	UINT32 firstmask = ~0U << (start % 32);
+	UINT32 lastmask = ~0U >> (31 - end % 32);
+	if (firstword == lastword)
+		m_dirty[firstword] |= firstmask & lastmask;
+	else
+	{
+		m_dirty[firstword] |= firstmask;
+		for (UINT32 word = firstword + 1; word < lastword; word++)
+			m_dirty[word] = ~0U;
+		m_dirty[lastword] |= lastmask;
+	}
+	m_mindirty = MIN(m_mindirty, start);
+	m_maxdirty = MAX(m_maxdirty, end);
+}
+
+
 //-------------------------------------------------
 //  reset - clear the dirty array to mark all
 //  entries as clean
@@ -208,6 +254,7 @@ palette_t::palette_t(UINT32 numcolors, UINT32 numgroups)
 	: m_refcount(1),
 		m_numcolors(numcolors),
 		m_numgroups(numgroups),
+		m_serial(0),
 		m_brightness(0.0f),
 		m_contrast(1.0f),
 		m_gamma(1.0f),
@@ -217,6 +264,7 @@ palette_t::palette_t(UINT32 numcolors, UINT32 numgroups)
 		m_adjusted_rgb15(numcolors * numgroups + 2),
 		m_group_bright(numgroups),
 		m_group_contrast(numgroups),
+		m_group_lut(numgroups * 256),
 		m_client_list(NULL)
 {
 	// initialize gamma map
@@ -235,6 +283,7 @@ palette_t::palette_t(UINT32 numcolors, UINT32 numgroups)
 	{
 		m_group_bright[index] = 0.0f;
 		m_group_contrast[index] = 1.0f;
+		update_group_lut(index);
 	}
 
 	// initialize the expanded data
@@ -289,8 +338,10 @@ void palette_t::set_brightness(float brightness)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+	{
+		update_group_lut(groupnum);
+		update_adjusted_range(groupnum, 0, m_numcolors);
+	}
 }
 
 
@@ -308,8 +359,10 @@ void palette_t::set_contrast(float contrast)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+	{
+		update_group_lut(groupnum);
+		update_adjusted_range(groupnum, 0, m_numcolors);
+	}
 }
 
 
@@ -336,8 +389,10 @@ void palette_t::set_gamma(float gamma)
 
 	// update across all indices in all groups
 	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
-		for (int index = 0; index < m_numcolors; index++)
-			update_adjusted_color(groupnum, index);
+	{
+		update_group_lut(groupnum);
+		update_adjusted_range(groupnum, 0, m_numcolors);
+	}
 }
 
 
@@ -361,6 +416,31 @@ void palette_t::entry_set_color(UINT32 index, rgb_t rgb)
 }
 
 
+//-------------------------------------------------
+//  entry_set_colors - set the raw RGB colors for
+//  a range of palette indexes in one batch
+//-------------------------------------------------
+
+void palette_t::entry_set_colors(UINT32 start, UINT32 count, const rgb_t *colors)
+{
+	// clip to the palette, then trim unchanged entries off both ends
+	if (start >= m_numcolors)
+		return;
+	count = MIN(count, m_numcolors - start);
+	while (count != 0 && m_entry_color[start] == colors[0])
+		start++, colors++, count--;
+	while (count != 0 && m_entry_color[start + count - 1] == colors[count - 1])
+		count--;
+	if (count == 0)
+		return;
+
+	// set the colors and update across all groups
+	memcpy(&m_entry_color[start], colors, count * sizeof(rgb_t));
+	for (int groupnum = 0; groupnum < m_numgroups; groupnum++)
+		update_adjusted_range(groupnum, start, count);
+}
+
+
 //-------------------------------------------------
 //  entry_set_contrast - set the contrast
 //  adjustment for a single palette index
@@ -399,8 +479,8 @@ void palette_t::group_set_brightness(UINT32 group, float brightness)
 	m_group_bright[group] = brightness;
 
 	// update across all colors
-	for (int index = 0; index < m_numcolors; index++)
-		update_adjusted_color(group, index);
+	update_group_lut(group);
+	update_adjusted_range(group, 0, m_numcolors);
 }
 
 
@@ -419,8 +499,8 @@ void palette_t::group_set_contrast(UINT32 group, float contrast)
 	m_group_contrast[group] = contrast;
 
 	// update across all colors
-	for (int index = 0; index < m_numcolors; index++)
-		update_adjusted_color(group, index);
+	update_group_lut(group);
+	update_adjusted_range(group, 0, m_numcolors);
 }
 
 
@@ -473,10 +553,7 @@ void palette_t::normalize_range(UINT32 start, UINT32 end, int lum_min, int lum_m
 void palette_t::update_adjusted_color(UINT32 group, UINT32 index)
 {
 	// compute the adjusted value
-	rgb_t adjusted = adjust_palette_entry(m_entry_color[index],
-											m_group_bright[group] + m_brightness,
-											m_group_contrast[group] * m_entry_contrast[index] * m_contrast,
-											m_gamma_map);
+	rgb_t adjusted = adjusted_color(group, index);
 
 	// if not different, ignore
 	UINT32 finalindex = group * m_numcolors + index;
@@ -486,8 +563,61 @@ void palette_t::update_adjusted_color(UINT32 group, UINT32 index)
 	// otherwise, modify the adjusted color array
 	m_adjusted_color[finalindex] = adjusted;
 	m_adjusted_rgb15[finalindex] = adjusted.as_rgb15();
+	m_serial++;
 
 	// mark dirty in all clients
 	for (palette_client *client = m_client_list; client != NULL; client = client->next())
 		client->mark_dirty(finalindex);
 }
+
+
+//-------------------------------------------------
+//  update_adjusted_range - update a run of color
+//  indexes within a group, marking the changed
+//  span dirty in all clients with one call
+//-------------------------------------------------
+
+void palette_t::update_adjusted_range(UINT32 group, UINT32 start, UINT32 count)
+{
+	UINT32 base = group * m_numcolors;
+	UINT32 mindirty = ~0, maxdirty = 0;
+	for (UINT32 index = start; index < start + count; index++)
+	{
+		// compute the adjusted value, skipping unchanged entries
+		rgb_t adjusted = adjusted_color(group, index);
+		UINT32 finalindex = base + index;
+		if (m_adjusted_color[finalindex] == adjusted)
+			continue;
+
+		// modify the adjusted color array
+		m_adjusted_color[finalindex] = adjusted;
+		m_adjusted_rgb15[finalindex] = adjusted.as_rgb15();
+		mindirty = MIN(mindirty, finalindex);
+		maxdirty = finalindex;
+	}
+
+	// if anything changed, mark the span dirty in all clients
+	if (mindirty <= maxdirty)
+	{
+		m_serial++;
+		for (palette_client *client = m_client_list; client != NULL; client = client->next())
+			client->mark_dirty_range(mindirty, maxdirty);
+	}
+}
+
+
+//-------------------------------------------------
+//  update_group_lut - rebuild the component map
+//  for a group after any brightness, contrast or
+//  gamma change; entries whose own contrast is
+//  1.0 are adjusted through it directly
+//-------------------------------------------------
+
+void palette_t::update_group_lut(UINT32 group)
+{
+	float brightness = m_group_bright[group] + m_brightness;
+	float contrast = m_group_contrast[group] * 1.0f * m_contrast;
+	UINT8 *lut = &m_group_lut[group * 256];
+	for (int value = 0; value < 256; value++)
+		lut[value] = rgb_t::clamp(float(m_gamma_map[value]) * contrast + brightness);
+}
@@ -101,6 +101,7 @@ public:
 
 	// dirty marking
 	void mark_dirty(UINT32 index) { m_live->mark_dirty(index); }
+	void mark_dirty_range(UINT32 start, UINT32 end) { m_live->mark_dirty_range(start, end); }
 
 private:
 	// internal object to track dirty states
@@ -114,6 +115,7 @@ private:
 		const UINT32 *dirty_list(UINT32 &mindirty, UINT32 &maxdirty);
 		void resize(UINT32 colors);
 		void mark_dirty(UINT32 index);
+		void mark_dirty_range(UINT32 start, UINT32 end);
 		void reset();
 
 	private:
@@ -153,6 +155,7 @@ public:
 	int max_index() const { return m_numcolors * m_numgroups + 2; }
 	UINT32 black_entry() const { return m_numcolors * m_numgroups + 0; }
 	UINT32 white_entry() const { return m_numcolors * m_numgroups + 1; }
+	UINT32 serial() const { return m_serial; }
 
 	// overall adjustments
 	void set_brightness(float brightness);
@@ -167,6 +170,7 @@ public:
 	// entry setters
 	void entry_set_color(UINT32 index, rgb_t rgb);
 	void entry_set_contrast(UINT32 index, float contrast);
+	void entry_set_colors(UINT32 start, UINT32 count, const rgb_t *colors);
 
 	// entry list getters
 	const rgb_t *entry_list_raw() const { return m_entry_color; }
@@ -187,12 +191,16 @@ private:
 
 	// internal helpers
 	rgb_t adjust_palette_entry(rgb_t entry, float brightness, float contrast, const UINT8 *gamma_map);
+	rgb_t adjusted_color(UINT32 group, UINT32 index);
 	void update_adjusted_color(UINT32 group, UINT32 index);
+	void update_adjusted_range(UINT32 group, UINT32 start, UINT32 count);
+	void update_group_lut(UINT32 group);
 
 	// internal state
 	UINT32          m_refcount;                   // reference count on the palette
 	UINT32          m_numcolors;                  // number of colors in the palette
 	UINT32          m_numgroups;                  // number of groups in the palette
+	UINT32          m_serial;                     // bumped whenever an adjusted color changes
 
 	float           m_brightness;                 // overall brightness value
 	float           m_contrast;                   // overall contrast value
@@ -206,6 +214,7 @@ private:
 
 	dynamic_array<float> m_group_bright;          // brightness value for each group
 	dynamic_array<float> m_group_contrast;        // contrast value for each group
+	dynamic_array<UINT8> m_group_lut;             // per-group component map for entries with unit contrast
 
 	palette_client *m_client_list;                // list of clients for this palette
 };
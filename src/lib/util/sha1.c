@@ -29,6 +29,22 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* The SHA extensions are used when the CPU has them; the compiler must be
+   able to target them per function, since the rest of the build may not
+   assume they exist */
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || (defined(_MSC_VER) && _MSC_VER >= 1900))
+#define SHA1_USE_SHANI 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHANI_TARGET
+#else
+#include <cpuid.h>
+#define SHANI_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+#endif
+#endif
+
 static unsigned int READ_UINT32(const UINT8* data)
 {
 	return ((UINT32)data[0] << 24) |
@@ -248,6 +264,129 @@ sha1_transform(UINT32 *state, UINT32 *data)
 	state[4] += E;
 }
 
+static int sha1_accelerated = 1;
+
+void
+sha1_set_accelerated(int enable)
+{
+	sha1_accelerated = enable;
+}
+
+#ifdef SHA1_USE_SHANI
+
+/* Return nonzero if the CPU has the SHA extensions, plus the SSSE3 and
+   SSE4.1 instructions used alongside them; racing threads all compute the
+   same answer */
+
+static int
+sha1_have_shani(void)
+{
+	static int have_shani = -1;
+	if (have_shani == -1)
+	{
+#ifdef _MSC_VER
+		int regs1[4], regs7[4];
+		__cpuid(regs1, 0);
+		if (regs1[0] < 7)
+			have_shani = 0;
+		else
+		{
+			__cpuid(regs1, 1);
+			__cpuidex(regs7, 7, 0);
+			have_shani = ((regs1[2] >> 9) & 1) && ((regs1[2] >> 19) & 1) && ((regs7[1] >> 29) & 1);
+		}
+#else
+		unsigned int eax, ebx, ecx, edx, eax7, ebx7, ecx7, edx7;
+		if (__get_cpuid_max(0, NULL) < 7 || !__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			have_shani = 0;
+		else
+		{
+			__cpuid_count(7, 0, eax7, ebx7, ecx7, edx7);
+			have_shani = ((ecx >> 9) & 1) && ((ecx >> 19) & 1) && ((ebx7 >> 29) & 1);
+		}
+#endif
+	}
+	return have_shani;
+}
+
+/* Four rounds with the SHA extensions, scheduling the message words for
+   later rounds as it goes: e is the E value for these rounds, eo receives
+   the one for the next, mc holds the current message words and mn, mx and
+   mp the following three groups */
+
+#define shaniRounds(e, eo, mc, mn, mx, mp, f) \
+	( e = _mm_sha1nexte_epu32(e, mc), eo = abcd, \
+	  mn = _mm_sha1msg2_epu32(mn, mc), abcd = _mm_sha1rnds4_epu32(abcd, e, f), \
+	  mp = _mm_sha1msg1_epu32(mp, mc), mx = _mm_xor_si128(mx, mc) )
+
+/* Hash whole blocks with the SHA extensions */
+
+static SHANI_TARGET void
+sha1_blocks_shani(UINT32 *state, const UINT8 *data, unsigned blocks)
+{
+	const __m128i bswap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+	__m128i abcd, e0, e1, msg0, msg1, msg2, msg3;
+
+	/* A ends up in the top lane, as does E */
+	abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state), 0x1b);
+	e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+	for ( ; blocks != 0; blocks--, data += SHA1_DATA_SIZE)
+	{
+		__m128i abcd_save = abcd;
+		__m128i e0_save = e0;
+
+		/* Rounds 0-15 load the block as they go */
+		msg0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 0)), bswap);
+		e0 = _mm_add_epi32(e0, msg0);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+		msg1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 16)), bswap);
+		e1 = _mm_sha1nexte_epu32(e1, msg1);
+		e0 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+		msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+		msg2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 32)), bswap);
+		e0 = _mm_sha1nexte_epu32(e0, msg2);
+		e1 = abcd;
+		abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+		msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+		msg0 = _mm_xor_si128(msg0, msg2);
+
+		msg3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + 48)), bswap);
+		shaniRounds(e1, e0, msg3, msg0, msg1, msg2, 0);
+
+		/* Rounds 16-79; the scheduling in the last few is wasted but harmless */
+		shaniRounds(e0, e1, msg0, msg1, msg2, msg3, 0);
+		shaniRounds(e1, e0, msg1, msg2, msg3, msg0, 1);
+		shaniRounds(e0, e1, msg2, msg3, msg0, msg1, 1);
+		shaniRounds(e1, e0, msg3, msg0, msg1, msg2, 1);
+		shaniRounds(e0, e1, msg0, msg1, msg2, msg3, 1);
+		shaniRounds(e1, e0, msg1, msg2, msg3, msg0, 1);
+		shaniRounds(e0, e1, msg2, msg3, msg0, msg1, 2);
+		shaniRounds(e1, e0, msg3, msg0, msg1, msg2, 2);
+		shaniRounds(e0, e1, msg0, msg1, msg2, msg3, 2);
+		shaniRounds(e1, e0, msg1, msg2, msg3, msg0, 2);
+		shaniRounds(e0, e1, msg2, msg3, msg0, msg1, 2);
+		shaniRounds(e1, e0, msg3, msg0, msg1, msg2, 3);
+		shaniRounds(e0, e1, msg0, msg1, msg2, msg3, 3);
+		shaniRounds(e1, e0, msg1, msg2, msg3, msg0, 3);
+		shaniRounds(e0, e1, msg2, msg3, msg0, msg1, 3);
+		shaniRounds(e1, e0, msg3, msg0, msg1, msg2, 3);
+
+		/* Add this block's result to the state */
+		e0 = _mm_sha1nexte_epu32(e0, e0_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+	}
+
+	_mm_storeu_si128((__m128i *)state, _mm_shuffle_epi32(abcd, 0x1b));
+	state[4] = _mm_extract_epi32(e0, 3);
+}
+
+#endif
+
 static void
 sha1_block(struct sha1_ctx *ctx, const UINT8 *block)
 {
@@ -286,6 +425,18 @@ sha1_update(struct sha1_ctx *ctx,
 		length -= left;
 	}
 	}
+#ifdef SHA1_USE_SHANI
+	if (length >= SHA1_DATA_SIZE && sha1_accelerated && sha1_have_shani())
+	{ /* Hash all the whole blocks at once */
+		unsigned blocks = length / SHA1_DATA_SIZE;
+		sha1_blocks_shani(ctx->digest, buffer, blocks);
+		ctx->count_low += blocks;
+		if (ctx->count_low < blocks)
+			++ctx->count_high;
+		buffer += blocks * SHA1_DATA_SIZE;
+		length -= blocks * SHA1_DATA_SIZE;
+	}
+#endif
 	while (length >= SHA1_DATA_SIZE)
 	{
 		sha1_block(ctx, buffer);
@@ -58,4 +58,9 @@ sha1_digest(const struct sha1_ctx *ctx,
 		unsigned length,
 		UINT8 *digest);
 
+/* Nonzero (the default) lets sha1_update use the CPU's SHA extensions
+   when it has them; zero forces the portable code */
+void
+sha1_set_accelerated(int enable);
+
 #endif /* NETTLE_SHA1_H_INCLUDED */
@@ -11,6 +11,7 @@
 // this is based on unzip.c, with modifications needed to use the 7zip library
 
 #include "osdcore.h"
+#include "eminline.h"
 #include "un7z.h"
 
 #include <ctype.h>
@@ -161,6 +162,9 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 /* number of open files to cache */
 #define _7Z_CACHE_SIZE  8
 
+/* decoded solid block bytes kept across all cached files */
+#define _7Z_BLOCK_CACHE_BYTES   ((size_t)256 * 1024 * 1024)
+
 
 /***************************************************************************
     GLOBAL VARIABLES
@@ -174,12 +178,35 @@ static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 
 /* cache management */
 static void free__7z_file(_7z_file *_7z);
+static void _7z_select_block(_7z_file *_7z, UInt32 folderIndex);
+static size_t _7z_block_bytes(_7z_file *_7z);
+static void _7z_trim_blocks(_7z_file *_7z, size_t budget);
 
 
 /***************************************************************************
     _7Z FILE ACCESS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    _7z_cache_lock - return the lock guarding
+    the cache, allocating it on first use; the
+    cache may be shared by several threads
+-------------------------------------------------*/
+
+static osd_lock *_7z_cache_lock(void)
+{
+	static osd_lock *volatile lock;
+
+	if (lock == NULL)
+	{
+		osd_lock *newlock = osd_lock_alloc();
+		if (compare_exchange_ptr((void * volatile *)&lock, NULL, newlock) != NULL)
+			osd_lock_free(newlock);
+	}
+	return lock;
+}
+
+
 /*-------------------------------------------------
     _7z_file_open - opens a _7Z file for reading
 -------------------------------------------------*/
@@ -291,6 +318,7 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	*_7z = NULL;
 
 	/* see if we are in the cache, and reopen if so */
+	osd_lock_acquire(_7z_cache_lock());
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 	{
 		_7z_file *cached = _7z_cache[cachenum];
@@ -300,9 +328,11 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		{
 			*_7z = cached;
 			_7z_cache[cachenum] = NULL;
+			osd_lock_release(_7z_cache_lock());
 			return _7ZERR_NONE;
 		}
 	}
+	osd_lock_release(_7z_cache_lock());
 
 	/* allocate memory for the _7z_file structure */
 	new_7z = (_7z_file *)malloc(sizeof(*new_7z));
@@ -386,6 +416,7 @@ void _7z_file_close(_7z_file *_7z)
 	_7z->archiveStream.file._7z_osdfile = NULL;
 
 	/* find the first NULL entry in the cache */
+	osd_lock_acquire(_7z_cache_lock());
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] == NULL)
 			break;
@@ -398,6 +429,21 @@ void _7z_file_close(_7z_file *_7z)
 	if (cachenum != 0)
 		memmove(&_7z_cache[1], &_7z_cache[0], cachenum * sizeof(_7z_cache[0]));
 	_7z_cache[0] = _7z;
+
+	/* keep the decoded blocks within budget, dropping those of the oldest files first */
+	size_t total = 0;
+	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
+		if (_7z_cache[cachenum] != NULL)
+			total += _7z_block_bytes(_7z_cache[cachenum]);
+	for (cachenum = ARRAY_LENGTH(_7z_cache) - 1; cachenum >= 0 && total > _7Z_BLOCK_CACHE_BYTES; cachenum--)
+		if (_7z_cache[cachenum] != NULL)
+		{
+			size_t bytes = _7z_block_bytes(_7z_cache[cachenum]);
+			size_t others = total - bytes;
+			_7z_trim_blocks(_7z_cache[cachenum], (others < _7Z_BLOCK_CACHE_BYTES) ? _7Z_BLOCK_CACHE_BYTES - others : 0);
+			total = others + _7z_block_bytes(_7z_cache[cachenum]);
+		}
+	osd_lock_release(_7z_cache_lock());
 }
 
 
@@ -411,12 +457,14 @@ void _7z_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	osd_lock_acquire(_7z_cache_lock());
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] != NULL)
 		{
 			free__7z_file(_7z_cache[cachenum]);
 			_7z_cache[cachenum] = NULL;
 		}
+	osd_lock_release(_7z_cache_lock());
 }
 
 
@@ -443,6 +491,12 @@ _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length)
 	size_t offset = 0;
 	size_t outSizeProcessed = 0;
 
+	/* if the file's solid block isn't the current one, bring back an earlier
+	   decoded copy so that it isn't decoded again from the start */
+	UInt32 folderIndex = new_7z->db.FileIndexToFolderIndexMap[index];
+	if (new_7z->outBuffer == NULL || new_7z->blockIndex != folderIndex)
+		_7z_select_block(new_7z, folderIndex);
+
 	res = SzArEx_Extract(&new_7z->db, &new_7z->lookStream.s, index,
 		&new_7z->blockIndex, &new_7z->outBuffer, &new_7z->outBufferSize,
 		&offset, &outSizeProcessed,
@@ -451,6 +505,9 @@ _7z_error _7z_file_decompress(_7z_file *new_7z, void *buffer, UINT32 length)
 	if (res != SZ_OK)
 		return _7ZERR_FILE_ERROR;
 
+	/* don't let a single file hold more than the whole cache budget */
+	_7z_trim_blocks(new_7z, _7Z_BLOCK_CACHE_BYTES);
+
 	memcpy(buffer, new_7z->outBuffer + offset, length);
 
 	return _7ZERR_NONE;
@@ -478,9 +535,111 @@ static void free__7z_file(_7z_file *_7z)
 
 
 		if (_7z->outBuffer) IAlloc_Free(&_7z->allocImp, _7z->outBuffer);
+		for (int sparenum = 0; sparenum < _7Z_SPARE_BLOCKS; sparenum++)
+			if (_7z->spare[sparenum].buffer) IAlloc_Free(&_7z->allocImp, _7z->spare[sparenum].buffer);
 		if (_7z->inited) SzArEx_Free(&_7z->db, &_7z->allocImp);
 
 
 		free(_7z);
 	}
 }
+
+
+/*-------------------------------------------------
+    _7z_select_block - make the given solid
+    block the current one, taking it from the
+    spares if it was decoded before; otherwise
+    the current block is set aside so that the
+    next extract decodes into a fresh buffer
+-------------------------------------------------*/
+
+static void _7z_select_block(_7z_file *_7z, UInt32 folderIndex)
+{
+	_7z_block current = { _7z->blockIndex, _7z->outBuffer, _7z->outBufferSize };
+	int sparenum;
+
+	/* look for the block among the spares */
+	for (sparenum = 0; sparenum < _7Z_SPARE_BLOCKS; sparenum++)
+		if (_7z->spare[sparenum].buffer != NULL && _7z->spare[sparenum].index == folderIndex)
+			break;
+
+	/* make it current, or leave nothing current so the SDK decodes it */
+	if (sparenum < _7Z_SPARE_BLOCKS)
+	{
+		_7z->blockIndex = _7z->spare[sparenum].index;
+		_7z->outBuffer = _7z->spare[sparenum].buffer;
+		_7z->outBufferSize = _7z->spare[sparenum].size;
+		_7z->spare[sparenum].buffer = NULL;
+	}
+	else
+	{
+		_7z->blockIndex = 0xFFFFFFFF;
+		_7z->outBuffer = NULL;
+		_7z->outBufferSize = 0;
+		sparenum = _7Z_SPARE_BLOCKS - 1;
+		if (current.buffer != NULL && _7z->spare[sparenum].buffer != NULL)
+		{
+			IAlloc_Free(&_7z->allocImp, _7z->spare[sparenum].buffer);
+			_7z->spare[sparenum].buffer = NULL;
+		}
+		if (current.buffer == NULL)
+			return;
+	}
+
+	/* the old current block becomes the most recent spare */
+	if (current.buffer != NULL)
+	{
+		memmove(&_7z->spare[1], &_7z->spare[0], sparenum * sizeof(_7z->spare[0]));
+		_7z->spare[0] = current;
+	}
+	else
+	{
+		memmove(&_7z->spare[sparenum], &_7z->spare[sparenum + 1], (_7Z_SPARE_BLOCKS - 1 - sparenum) * sizeof(_7z->spare[0]));
+		_7z->spare[_7Z_SPARE_BLOCKS - 1].buffer = NULL;
+	}
+}
+
+
+/*-------------------------------------------------
+    _7z_block_bytes - return the number of
+    decoded bytes held by a _7z_file
+-------------------------------------------------*/
+
+static size_t _7z_block_bytes(_7z_file *_7z)
+{
+	size_t bytes = (_7z->outBuffer != NULL) ? _7z->outBufferSize : 0;
+	for (int sparenum = 0; sparenum < _7Z_SPARE_BLOCKS; sparenum++)
+		if (_7z->spare[sparenum].buffer != NULL)
+			bytes += _7z->spare[sparenum].size;
+	return bytes;
+}
+
+
+/*-------------------------------------------------
+    _7z_trim_blocks - free decoded blocks of a
+    _7z_file, oldest spare first and the current
+    block last, until it holds no more than the
+    given number of bytes
+-------------------------------------------------*/
+
+static void _7z_trim_blocks(_7z_file *_7z, size_t budget)
+{
+	size_t bytes = _7z_block_bytes(_7z);
+
+	for (int sparenum = _7Z_SPARE_BLOCKS - 1; sparenum >= 0 && bytes > budget; sparenum--)
+		if (_7z->spare[sparenum].buffer != NULL)
+		{
+			bytes -= _7z->spare[sparenum].size;
+			IAlloc_Free(&_7z->allocImp, _7z->spare[sparenum].buffer);
+			_7z->spare[sparenum].buffer = NULL;
+		}
+
+	/* the current block may only go once the file is back in the cache */
+	if (bytes > budget && _7z->outBuffer != NULL && _7z->archiveStream.file._7z_osdfile == NULL)
+	{
+		IAlloc_Free(&_7z->allocImp, _7z->outBuffer);
+		_7z->blockIndex = 0xFFFFFFFF;
+		_7z->outBuffer = NULL;
+		_7z->outBufferSize = 0;
+	}
+}
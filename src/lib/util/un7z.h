@@ -68,6 +68,9 @@ void FileOutStream_CreateVTable(CFileOutStream *p);
     CONSTANTS
 ***************************************************************************/
 
+/* number of earlier decoded solid blocks kept per archive */
+#define _7Z_SPARE_BLOCKS    3
+
 
 /* Error types */
 enum _7z_error
@@ -89,6 +92,15 @@ enum _7z_error
     TYPE DEFINITIONS
 ***************************************************************************/
 
+/* a decoded solid block kept for reuse */
+struct _7z_block
+{
+	UInt32 index;                           /* folder index of the block */
+	Byte *buffer;                           /* decoded data, or NULL if unused */
+	size_t size;                            /* size of the decoded data */
+};
+
+
 /* describes an open _7Z file */
 struct  _7z_file
 {
@@ -110,6 +122,7 @@ struct  _7z_file
 	UInt32 blockIndex;// = 0xFFFFFFFF; /* it can have any value before first call (if outBuffer = 0) */
 	Byte *outBuffer;// = 0; /* it must be 0 before first call for each new archive. */
 	size_t outBufferSize;// = 0;  /* it can have any value before first call (if outBuffer = 0) */
+	_7z_block spare[_7Z_SPARE_BLOCKS];      /* earlier decoded blocks, most recently used first */
 };
 
 
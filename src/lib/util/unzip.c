@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "osdcore.h"
+#include "eminline.h"
 #include "unzip.h"
 
 #include <ctype.h>
@@ -21,8 +22,8 @@
     CONSTANTS
 ***************************************************************************/
 
-/* number of open files to cache */
-#define ZIP_CACHE_SIZE  8
+/* number of open files to cache; closed entries hold only the central directory */
+#define ZIP_CACHE_SIZE  32
 
 /* offsets in end of central directory structure */
 #define ZIPESIG         0x00
@@ -118,6 +119,26 @@ static zip_error decompress_data_type_8(zip_file *zip, UINT64 offset, void *buff
     ZIP FILE ACCESS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    zip_cache_lock - return the lock guarding
+    the cache, allocating it on first use; the
+    cache may be shared by several threads
+-------------------------------------------------*/
+
+static osd_lock *zip_cache_lock(void)
+{
+	static osd_lock *volatile lock;
+
+	if (lock == NULL)
+	{
+		osd_lock *newlock = osd_lock_alloc();
+		if (compare_exchange_ptr((void * volatile *)&lock, NULL, newlock) != NULL)
+			osd_lock_free(newlock);
+	}
+	return lock;
+}
+
+
 /*-------------------------------------------------
     zip_file_open - opens a ZIP file for reading
 -------------------------------------------------*/
@@ -135,6 +156,7 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	*zip = NULL;
 
 	/* see if we are in the cache, and reopen if so */
+	osd_lock_acquire(zip_cache_lock());
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 	{
 		zip_file *cached = zip_cache[cachenum];
@@ -144,9 +166,11 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		{
 			*zip = cached;
 			zip_cache[cachenum] = NULL;
+			osd_lock_release(zip_cache_lock());
 			return ZIPERR_NONE;
 		}
 	}
+	osd_lock_release(zip_cache_lock());
 
 	/* allocate memory for the zip_file structure */
 	newzip = (zip_file *)malloc(sizeof(*newzip));
@@ -223,6 +247,7 @@ void zip_file_close(zip_file *zip)
 	zip->file = NULL;
 
 	/* find the first NULL entry in the cache */
+	osd_lock_acquire(zip_cache_lock());
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] == NULL)
 			break;
@@ -235,6 +260,7 @@ void zip_file_close(zip_file *zip)
 	if (cachenum != 0)
 		memmove(&zip_cache[1], &zip_cache[0], cachenum * sizeof(zip_cache[0]));
 	zip_cache[0] = zip;
+	osd_lock_release(zip_cache_lock());
 }
 
 
@@ -248,12 +274,14 @@ void zip_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	osd_lock_acquire(zip_cache_lock());
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] != NULL)
 		{
 			free_zip_file(zip_cache[cachenum]);
 			zip_cache[cachenum] = NULL;
 		}
+	osd_lock_release(zip_cache_lock());
 }
 
 
@@ -375,6 +403,37 @@ zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length)
 
 
 
+/*-------------------------------------------------
+    zip_file_map - map the most recently found
+    file straight out of the ZIP, if it is stored
+    without compression
+-------------------------------------------------*/
+
+zip_error zip_file_map(zip_file *zip, void **base)
+{
+	zip_error ziperr;
+	UINT64 offset;
+
+	/* only stored, unencrypted data can be used in place */
+	if (zip->header.compression != 0 || (zip->header.bit_flag & 1) != 0 || zip->header.uncompressed_length == 0)
+		return ZIPERR_UNSUPPORTED;
+	if (zip->header.start_disk_number != zip->ecd.disk_number)
+		return ZIPERR_UNSUPPORTED;
+
+	/* get the data offset; this also reopens the file if needed */
+	ziperr = get_compressed_data_offset(zip, &offset);
+	if (ziperr != ZIPERR_NONE)
+		return ziperr;
+	if (offset + zip->header.uncompressed_length > zip->length)
+		return ZIPERR_FILE_TRUNCATED;
+
+	if (osd_map(zip->file, offset, zip->header.uncompressed_length, base) != FILERR_NONE)
+		return ZIPERR_UNSUPPORTED;
+	return ZIPERR_NONE;
+}
+
+
+
 /***************************************************************************
     CACHE MANAGEMENT
 ***************************************************************************/
@@ -134,5 +134,8 @@ const zip_file_header *zip_file_next_file(zip_file *zip);
 /* decompress the most recently found file in the ZIP */
 zip_error zip_file_decompress(zip_file *zip, void *buffer, UINT32 length);
 
+/* map the most recently found file copy-on-write, if it is stored uncompressed; release with osd_unmap */
+zip_error zip_file_map(zip_file *zip, void **base);
+
 
 #endif  /* __UNZIP_H__ */
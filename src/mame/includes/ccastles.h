@@ -43,7 +43,6 @@ public:
 	double m_bweights[3];
 	UINT8 m_video_control[8];
 	UINT8 m_bitmode_addr[2];
-	UINT8 m_hscroll;
 	UINT8 m_vscroll;
 
 	/* misc */
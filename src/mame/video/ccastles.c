@@ -9,6 +9,13 @@
 #include "video/resnet.h"
 
 
+/* batched raster registers */
+enum
+{
+	RASTER_HSCROLL = 0
+};
+
+
 /*************************************
  *
  *  Video startup
@@ -33,10 +40,12 @@ void ccastles_state::video_start()
 	/* allocate a bitmap for drawing sprites */
 	m_screen->register_screen_bitmap(m_spritebitmap);
 
+	/* hscroll changes mid-frame; let the screen log them instead of splitting the update */
+	m_screen->set_raster_registers(1);
+
 	/* register for savestates */
 	save_item(NAME(m_video_control));
 	save_item(NAME(m_bitmode_addr));
-	save_item(NAME(m_hscroll));
 	save_item(NAME(m_vscroll));
 }
 
@@ -50,8 +59,7 @@ void ccastles_state::video_start()
 
 WRITE8_MEMBER(ccastles_state::ccastles_hscroll_w)
 {
-	m_screen->update_partial(m_screen->vpos());
-	m_hscroll = data;
+	m_screen->raster_write(RASTER_HSCROLL, data);
 }
 
 
@@ -286,6 +294,7 @@ UINT32 ccastles_state::screen_update_ccastles(screen_device &screen, bitmap_ind1
 		else
 		{
 			UINT16 *mosrc = &m_spritebitmap.pix16(y);
+			int hscroll = screen.raster_read(RASTER_HSCROLL, y);
 			int effy = (((y - m_vblank_end) + (flip ? 0 : m_vscroll)) ^ flip) & 0xff;
 			UINT8 *src;
 
@@ -304,7 +313,7 @@ UINT32 ccastles_state::screen_update_ccastles(screen_device &screen, bitmap_ind1
 				/* otherwise, process normally */
 				else
 				{
-					int effx = (m_hscroll + (x ^ flip)) & 255;
+					int effx = (hscroll + (x ^ flip)) & 255;
 
 					/* low 4 bits = left pixel, high 4 bits = right pixel */
 					UINT8 pix = (src[effx / 2] >> ((effx & 1) * 4)) & 0x0f;
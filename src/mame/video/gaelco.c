@@ -192,17 +192,18 @@ UINT32 gaelco_state::screen_update_maniacsq(screen_device &screen, bitmap_ind16
 	screen.priority().fill(0, cliprect);
 	bitmap.fill(0, cliprect);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, 3, 0);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, 3, 0);
+	/* each layer pass covers the whole screen, so split them across threads */
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 3, 0);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 3, 0);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, 2, 1);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, 2, 1);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 2, 1);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 2, 1);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, 1, 2);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, 1, 2);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 1, 2);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 1, 2);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, 0, 4);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, 0, 4);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 0, 4);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | 0, 4);
 
 	draw_sprites(screen, bitmap, cliprect);
 	return 0;
@@ -219,29 +220,30 @@ UINT32 gaelco_state::screen_update_bigkarnk(screen_device &screen, bitmap_ind16
 	screen.priority().fill(0, cliprect);
 	bitmap.fill(0, cliprect);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 3, 0);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 3, 0);
+	/* each layer pass covers the whole screen, so split them across threads */
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 3, 0);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 3, 0);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 3, 1);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 3, 1);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 3, 1);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 3, 1);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 2, 1);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 2, 1);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 2, 1);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 2, 1);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 2, 2);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 2, 2);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 2, 2);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 2, 2);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 1, 2);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 1, 2);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 1, 2);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 1, 2);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 1, 4);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 1, 4);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 1, 4);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 1, 4);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 0, 4);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER1 | 0, 4);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 0, 4);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER1 | 0, 4);
 
-	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 0, 8);
-	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_LAYER0 | 0, 8);
+	m_tilemap[1]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 0, 8);
+	m_tilemap[0]->draw(screen, bitmap, cliprect, TILEMAP_DRAW_BANDED | TILEMAP_DRAW_LAYER0 | 0, 8);
 
 	draw_sprites(screen, bitmap, cliprect);
 	return 0;
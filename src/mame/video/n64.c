@@ -406,28 +406,14 @@ void n64_rdp::TCDiv(INT32 ss, INT32 st, INT32 sw, INT32* sss, INT32* sst)
 	*sst = (*sst & 0x1ffff) | (over_t << 18) | (under_t << 17);
 }
 
-INT32 n64_rdp::ColorCombinerEquation(INT32 a, INT32 b, INT32 c, INT32 d)
-{
-	a = KURT_AKELEY_SIGN9(a);
-	b = KURT_AKELEY_SIGN9(b);
-	c = SIGN9(c);
-	d = KURT_AKELEY_SIGN9(d);
-	a = (((a - b) * c) + (d << 8) + 0x80);
-	a = SIGN17(a) >> 8;
-	a = s_special_9bit_clamptable[a & 0x1ff];
-	return a;
-}
-
-INT32 n64_rdp::AlphaCombinerEquation(INT32 a, INT32 b, INT32 c, INT32 d)
-{
-	a = KURT_AKELEY_SIGN9(a);
-	b = KURT_AKELEY_SIGN9(b);
-	c = SIGN9(c);
-	d = KURT_AKELEY_SIGN9(d);
-	a = (((a - b) * c) + (d << 8) + 0x80) >> 8;
-	a = SIGN9(a);
-	a = s_special_9bit_clamptable[a & 0x1ff];
-	return a;
+// Evaluates one combiner cycle through the reduced equations in rdpcomb.h.
+void n64_rdp::CombinerCycle(Color *out, const ColorInputsT &inputs, int cycle)
+{
+	out->c = rdp_combiner_cycle(*inputs.combiner_rgbsub_a_r[cycle], *inputs.combiner_rgbsub_a_g[cycle], *inputs.combiner_rgbsub_a_b[cycle], *inputs.combiner_alphasub_a[cycle],
+			*inputs.combiner_rgbsub_b_r[cycle], *inputs.combiner_rgbsub_b_g[cycle], *inputs.combiner_rgbsub_b_b[cycle], *inputs.combiner_alphasub_b[cycle],
+			*inputs.combiner_rgbmul_r[cycle], *inputs.combiner_rgbmul_g[cycle], *inputs.combiner_rgbmul_b[cycle], *inputs.combiner_alphamul[cycle],
+			*inputs.combiner_rgbadd_r[cycle], *inputs.combiner_rgbadd_g[cycle], *inputs.combiner_rgbadd_b[cycle], *inputs.combiner_alphaadd[cycle],
+			s_special_9bit_clamptable);
 }
 
 void n64_rdp::SetSubAInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata)
@@ -6,6 +6,7 @@
 #include "video/poly.h"
 #include "video/rdpblend.h"
 #include "video/rdptpipe.h"
+#include "video/rdpcomb.h"
 
 /*****************************************************************************/
 
@@ -97,17 +98,6 @@
 #define HREADADDR8(in)          /*(((in) <= MEM8_LIMIT) ? */(HiddenBits[(in) ^ BYTE_ADDR_XOR])/* : 0)*/
 #define HWRITEADDR8(in, val)    /*{if ((in) <= MEM8_LIMIT) */HiddenBits[(in) ^ BYTE_ADDR_XOR] = val;/*}*/
 
-//sign-extension macros
-#define SIGN22(x)   (((x) & 0x200000) ? ((x) | ~0x3fffff) : ((x) & 0x3fffff))
-#define SIGN17(x)   (((x) & 0x10000) ? ((x) | ~0x1ffff) : ((x) & 0x1ffff))
-#define SIGN16(x)   (((x) & 0x8000) ? ((x) | ~0xffff) : ((x) & 0xffff))
-#define SIGN13(x)   (((x) & 0x1000) ? ((x) | ~0x1fff) : ((x) & 0x1fff))
-#define SIGN11(x)   (((x) & 0x400) ? ((x) | ~0x7ff) : ((x) & 0x7ff))
-#define SIGN9(x)    (((x) & 0x100) ? ((x) | ~0x1ff) : ((x) & 0x1ff))
-#define SIGN8(x)    (((x) & 0x80) ? ((x) | ~0xff) : ((x) & 0xff))
-
-#define KURT_AKELEY_SIGN9(x)    ((((x) & 0x180) == 0x180) ? ((x) | ~0x1ff) : ((x) & 0x1ff))
-
 #define SPAN_R      (0)
 #define SPAN_G      (1)
 #define SPAN_B      (2)
@@ -456,8 +446,7 @@ class n64_rdp : public poly_manager<UINT32, rdp_poly_state, 8, 32000>
 		CombineModesT*  GetCombine() { return &m_combine; }
 
 		// Color Combiner
-		INT32       ColorCombinerEquation(INT32 a, INT32 b, INT32 c, INT32 d);
-		INT32       AlphaCombinerEquation(INT32 a, INT32 b, INT32 c, INT32 d);
+		void        CombinerCycle(Color *out, const ColorInputsT &inputs, int cycle);
 		void        SetSubAInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata);
 		void        SetSubBInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata);
 		void        SetMulInputRGB(UINT8 **input_r, UINT8 **input_g, UINT8 **input_b, int code, rdp_span_aux *userdata);
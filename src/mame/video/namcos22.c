@@ -42,8 +42,10 @@
 
 
 // polynew constructor
+// the scene is submitted and waited for within a single screen update, so
+// deferring the work to wait() with tile binning costs no overlap
 namcos22_renderer::namcos22_renderer(namcos22_state &state)
-	: poly_manager<float, namcos22_object_data, 4, 8000>(state.machine()),
+	: poly_manager<float, namcos22_object_data, 4, 8000>(state.machine(), POLYFLAG_TILE_BINNING),
 		m_state(state)
 	{ }
 
@@ -103,6 +103,7 @@ const int powervr2_device::pvr_wordspolygon[24] = {8,8,8,8,8, 8, 8,8,8,8,16,16,8
 
 #define DEBUG_FIFO_POLY (0)
 #define DEBUG_PVRTA 0
+#define PVR_REFERENCE_RENDER 0  // render the display list in one pass on the emulation thread
 #define DEBUG_PVRDLIST  (0)
 #define DEBUG_PALRAM (0)
 #define DEBUG_PVRCTRL   (0)
@@ -2250,7 +2251,7 @@ void powervr2_device::render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int y, flo
 	}
 }
 
-void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti, int miny, int maxy,
 									float y0, float y1,
 									float xl, float xr,
 									float ul, float ur,
@@ -2303,8 +2304,14 @@ void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 	wl += dy*dwldy;
 	wr += dy*dwrdy;
 
+	// step through the rows above the band rather than jumping ahead, so
+	// the edges come out exactly as they do when rendering in one pass
+	if(yy1 > maxy)
+		yy1 = maxy;
+
 	while(yy0 < yy1) {
-		render_hline(bitmap, ti, yy0, xl, xr, ul, ur, vl, vr, wl, wr);
+		if(yy0 >= miny)
+			render_hline(bitmap, ti, yy0, xl, xr, ul, ur, vl, vr, wl, wr);
 
 		xl += dxldy;
 		xr += dxrdy;
@@ -2349,7 +2356,7 @@ void powervr2_device::sort_vertices(const vert *v, int *i0, int *i1, int *i2)
 }
 
 
-void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
+void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, int miny, int maxy, const vert *v0, const vert *v1, const vert *v2)
 {
 	float dy01, dy02, dy12;
 
@@ -2358,6 +2365,10 @@ void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const
 	if(v0->y >= 480 || v2->y < 0)
 		return;
 
+	// rows are rounded from y, so allow a line of slack on either side
+	if(v0->y >= maxy + 1 || v2->y < miny - 1)
+		return;
+
 	dy01 = v1->y - v0->y;
 	dy02 = v2->y - v0->y;
 	dy12 = v2->y - v1->y;
@@ -2383,41 +2394,69 @@ void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const
 			return;
 
 		if(v1->x > v0->x)
-			render_span(bitmap, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy);
+			render_span(bitmap, ti, miny, maxy, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy);
 		else
-			render_span(bitmap, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy);
+			render_span(bitmap, ti, miny, maxy, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy);
 
 	} else if(!dy12) {
 		if(v2->x > v1->x)
-			render_span(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy);
+			render_span(bitmap, ti, miny, maxy, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy);
 		else
-			render_span(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy);
+			render_span(bitmap, ti, miny, maxy, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy);
 
 	} else {
 		if(dx01dy < dx02dy) {
-			render_span(bitmap, ti, v0->y, v1->y,
+			render_span(bitmap, ti, miny, maxy, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w,
 						dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy);
-			render_span(bitmap, ti, v1->y, v2->y,
+			render_span(bitmap, ti, miny, maxy, v1->y, v2->y,
 						v1->x, v0->x + dx02dy*dy01, v1->u, v0->u + du02dy*dy01, v1->v, v0->v + dv02dy*dy01, v1->w, v0->w + dw02dy*dy01,
 						dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy);
 		} else {
-			render_span(bitmap, ti, v0->y, v1->y,
+			render_span(bitmap, ti, miny, maxy, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w,
 						dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy);
-			render_span(bitmap, ti, v1->y, v2->y,
+			render_span(bitmap, ti, miny, maxy, v1->y, v2->y,
 						v0->x + dx02dy*dy01, v1->x, v0->u + du02dy*dy01, v1->u, v0->v + dv02dy*dy01, v1->v, v0->w + dw02dy*dy01, v1->w,
 						dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy);
 		}
 	}
 }
 
-void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v)
+void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, int miny, int maxy, const vert *v)
 {
 	int i0, i1, i2;
 
 	sort_vertices(v, &i0, &i1, &i2);
-	render_tri_sorted(bitmap, ti, v+i0, v+i1, v+i2);
+	render_tri_sorted(bitmap, ti, miny, maxy, v+i0, v+i1, v+i2);
+}
+
+void powervr2_device::render_strips(bitmap_rgb32 &bitmap, int miny, int maxy)
+{
+	int rs=renderselect;
+	int ns=grab[rs].strips_size;
+
+	for (int cs=0;cs < ns;cs++)
+	{
+		strip *ts = &grab[rs].strips[cs];
+		int sv = ts->svert;
+		int ev = ts->evert;
+		if(ev == -1)
+			continue;
+
+		for(int i=sv; i <= ev-2; i++)
+		{
+			if (!(debug_dip_status&0x2))
+				render_tri(bitmap, &ts->ti, miny, maxy, grab[rs].verts + i);
+		}
+	}
+}
+
+void *powervr2_device::render_band_callback(void *param, int threadid)
+{
+	render_band *band = (render_band *)param;
+	band->pvr->render_strips(*band->bitmap, band->miny, band->maxy);
+	return NULL;
 }
 
 void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap,const rectangle &cliprect)
@@ -2460,14 +2499,25 @@ void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap,const r
 			tv->u = tv->u * ts->ti.sizex * tv->w;
 			tv->v = tv->v * ts->ti.sizey * tv->w;
 		}
+	}
 
-		for(i=sv; i <= ev-2; i++)
+	// strips never share vertices, so the whole list can be prepared up
+	// front and then rendered band by band
+	if (render_queue != NULL)
+	{
+		for (int band = 0; band < RENDER_BANDS; band++)
 		{
-			if (!(debug_dip_status&0x2))
-				render_tri(bitmap, &ts->ti, grab[rs].verts + i);
-
+			render_bands[band].pvr = this;
+			render_bands[band].bitmap = &bitmap;
+			render_bands[band].miny = band * RENDER_BAND_LINES;
+			render_bands[band].maxy = (band + 1) * RENDER_BAND_LINES;
 		}
+		osd_work_item_queue_multiple(render_queue, render_band_callback, RENDER_BANDS, render_bands, sizeof(render_bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		osd_work_queue_wait(render_queue, osd_ticks_per_second() * 10);
 	}
+	else
+		render_strips(bitmap, 0, 480);
+
 	grab[rs].busy=0;
 }
 
@@ -3625,6 +3675,10 @@ void powervr2_device::device_start()
 
 	fake_accumulationbuffer_bitmap = auto_bitmap_rgb32_alloc(machine(),2048,2048);
 
+	render_queue = NULL;
+	if (!PVR_REFERENCE_RENDER)
+		render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+
 	softreset = 0;
 	param_base = 0;
 	region_base = 0;
@@ -3740,6 +3794,12 @@ void powervr2_device::device_start()
 	save_item(NAME(next_y));
 }
 
+void powervr2_device::device_stop()
+{
+	if (render_queue != NULL)
+		osd_work_queue_free(render_queue);
+}
+
 void powervr2_device::device_reset()
 {
 	softreset =                 0x00000007;
@@ -50,6 +50,18 @@ public:
 	int dilatechose[64];
 	float wbuffer[480][640];
 
+	// the display list is rendered in bands of scanlines on a work queue; each
+	// band owns its rows of the accumulation buffer and wbuffer, and walks the
+	// whole list in order, so the result matches rendering it in one pass
+	enum { RENDER_BAND_LINES = 32, RENDER_BANDS = 480 / RENDER_BAND_LINES };
+	struct render_band {
+		powervr2_device *pvr;
+		bitmap_rgb32 *bitmap;
+		int miny, maxy;
+	};
+	osd_work_queue *render_queue;
+	render_band render_bands[RENDER_BANDS];
+
 
 	// the real accumulation buffer is a 32x32x8bpp buffer into which tiles get rendered before they get copied to the framebuffer
 	//  our implementation is not currently tile based, and thus the accumulation buffer is screen sized
@@ -279,6 +291,7 @@ public:
 
 protected:
 	virtual void device_start();
+	virtual void device_stop();
 	virtual void device_reset();
 
 private:
@@ -428,7 +441,7 @@ private:
 	void tex_get_info(texinfo *t);
 
 	void render_hline(bitmap_rgb32 &bitmap, texinfo *ti, int y, float xl, float xr, float ul, float ur, float vl, float vr, float wl, float wr);
-	void render_span(bitmap_rgb32 &bitmap, texinfo *ti,
+	void render_span(bitmap_rgb32 &bitmap, texinfo *ti, int miny, int maxy,
 						float y0, float y1,
 						float xl, float xr,
 						float ul, float ur,
@@ -439,8 +452,10 @@ private:
 						float dvldy, float dvrdy,
 						float dwldy, float dwrdy);
 	void sort_vertices(const vert *v, int *i0, int *i1, int *i2);
-	void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2);
-	void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v);
+	void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, int miny, int maxy, const vert *v0, const vert *v1, const vert *v2);
+	void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, int miny, int maxy, const vert *v);
+	void render_strips(bitmap_rgb32 &bitmap, int miny, int maxy);
+	static void *render_band_callback(void *param, int threadid);
 	void render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 	void pvr_accumulationbuffer_to_framebuffer(address_space &space, int x, int y);
 	void pvr_drawframebuffer(bitmap_rgb32 &bitmap,const rectangle &cliprect);
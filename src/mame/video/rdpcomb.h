@@ -0,0 +1,120 @@
+/******************************************************************************
+
+
+    SGI/Nintendo Reality Display Processor Color Combiner (CC) arithmetic
+    -------------------
+
+    by MooglyGuy
+    based on initial C code by Ville Linde
+    contains additional improvements from angrylion, Ziggy, Gonetz and Orkin
+
+    The combiner equations for one cycle. The span renderers use the
+    reduced form, rdp_combiner_cycle; the full per-channel equations
+    and an SSE2 form are kept so that src/tools/rdpbench.c can check
+    the reduced form against the equations and time all three. This
+    header needs nothing from the rest of the RDP for that reason,
+    which is also why the RDP's sign-extension macros live here.
+
+
+******************************************************************************/
+
+#ifndef _VIDEO_RDPCOMB_H_
+#define _VIDEO_RDPCOMB_H_
+
+/* the SSE2 form is only built on 64-bit implementations, where it can be assumed */
+#if (defined(__SSE2__) || defined(_MSC_VER)) && defined(PTR64)
+#define RDP_COMBINER_SSE2       1
+#include <emmintrin.h>
+#endif
+
+//sign-extension macros
+#define SIGN22(x)   (((x) & 0x200000) ? ((x) | ~0x3fffff) : ((x) & 0x3fffff))
+#define SIGN17(x)   (((x) & 0x10000) ? ((x) | ~0x1ffff) : ((x) & 0x1ffff))
+#define SIGN16(x)   (((x) & 0x8000) ? ((x) | ~0xffff) : ((x) & 0xffff))
+#define SIGN13(x)   (((x) & 0x1000) ? ((x) | ~0x1fff) : ((x) & 0x1fff))
+#define SIGN11(x)   (((x) & 0x400) ? ((x) | ~0x7ff) : ((x) & 0x7ff))
+#define SIGN9(x)    (((x) & 0x100) ? ((x) | ~0x1ff) : ((x) & 0x1ff))
+#define SIGN8(x)    (((x) & 0x80) ? ((x) | ~0xff) : ((x) & 0xff))
+
+#define KURT_AKELEY_SIGN9(x)    ((((x) & 0x180) == 0x180) ? ((x) | ~0x1ff) : ((x) & 0x1ff))
+
+/*****************************************************************************/
+
+INLINE INT32 rdp_color_combiner_equation(INT32 a, INT32 b, INT32 c, INT32 d, const UINT32 *clamptable)
+{
+	a = KURT_AKELEY_SIGN9(a);
+	b = KURT_AKELEY_SIGN9(b);
+	c = SIGN9(c);
+	d = KURT_AKELEY_SIGN9(d);
+	a = (((a - b) * c) + (d << 8) + 0x80);
+	a = SIGN17(a) >> 8;
+	a = clamptable[a & 0x1ff];
+	return a;
+}
+
+INLINE INT32 rdp_alpha_combiner_equation(INT32 a, INT32 b, INT32 c, INT32 d, const UINT32 *clamptable)
+{
+	a = KURT_AKELEY_SIGN9(a);
+	b = KURT_AKELEY_SIGN9(b);
+	c = SIGN9(c);
+	d = KURT_AKELEY_SIGN9(d);
+	a = (((a - b) * c) + (d << 8) + 0x80) >> 8;
+	a = SIGN9(a);
+	a = clamptable[a & 0x1ff];
+	return a;
+}
+
+// One combiner cycle through the equations above, returned as R, G, B and
+// alpha from the top byte down, which is how Color::c holds them.
+INLINE UINT32 rdp_combiner_cycle_equations(INT32 ar, INT32 ag, INT32 ab, INT32 aa, INT32 br, INT32 bg, INT32 bb, INT32 ba,
+		INT32 cr, INT32 cg, INT32 cb, INT32 ca, INT32 dr, INT32 dg, INT32 db, INT32 da, const UINT32 *clamptable)
+{
+	return ((UINT32)rdp_color_combiner_equation(ar, br, cr, dr, clamptable) << 24) |
+			((UINT32)rdp_color_combiner_equation(ag, bg, cg, dg, clamptable) << 16) |
+			((UINT32)rdp_color_combiner_equation(ab, bb, cb, db, clamptable) << 8) |
+			(UINT32)rdp_alpha_combiner_equation(aa, ba, ca, da, clamptable);
+}
+
+// The combiner inputs are all 8-bit, so the sign extensions in the equations
+// leave them alone, and for both equations the clamp table index is bits 8-16
+// of the sum.
+INLINE UINT32 rdp_combiner_channel(INT32 a, INT32 b, INT32 c, INT32 d, const UINT32 *clamptable)
+{
+	return clamptable[((((a - b) * c) + (d << 8) + 0x80) >> 8) & 0x1ff];
+}
+
+INLINE UINT32 rdp_combiner_cycle(INT32 ar, INT32 ag, INT32 ab, INT32 aa, INT32 br, INT32 bg, INT32 bb, INT32 ba,
+		INT32 cr, INT32 cg, INT32 cb, INT32 ca, INT32 dr, INT32 dg, INT32 db, INT32 da, const UINT32 *clamptable)
+{
+	return (rdp_combiner_channel(ar, br, cr, dr, clamptable) << 24) |
+			(rdp_combiner_channel(ag, bg, cg, dg, clamptable) << 16) |
+			(rdp_combiner_channel(ab, bb, cb, db, clamptable) << 8) |
+			rdp_combiner_channel(aa, ba, ca, da, clamptable);
+}
+
+#ifdef RDP_COMBINER_SSE2
+// The same reduction four channels at a time. Packing the sixteen inputs into
+// registers and unpacking the four clamp table indices costs more than the
+// arithmetic it saves, so rdpbench measures this slower than the scalar form.
+INLINE UINT32 rdp_combiner_cycle_sse2(INT32 ar, INT32 ag, INT32 ab, INT32 aa, INT32 br, INT32 bg, INT32 bb, INT32 ba,
+		INT32 cr, INT32 cg, INT32 cb, INT32 ca, INT32 dr, INT32 dg, INT32 db, INT32 da, const UINT32 *clamptable)
+{
+	__m128i a = _mm_setr_epi16(ar, ag, ab, aa, 0, 0, 0, 0);
+	__m128i b = _mm_setr_epi16(br, bg, bb, ba, 0, 0, 0, 0);
+	__m128i c = _mm_setr_epi16(cr, cg, cb, ca, 0, 0, 0, 0);
+	__m128i d = _mm_setr_epi32(dr, dg, db, da);
+
+	// (a - b) * c needs 17 bits, so build it from the low and high halves
+	__m128i diff = _mm_sub_epi16(a, b);
+	__m128i sum = _mm_unpacklo_epi16(_mm_mullo_epi16(diff, c), _mm_mulhi_epi16(diff, c));
+	sum = _mm_add_epi32(sum, _mm_add_epi32(_mm_slli_epi32(d, 8), _mm_set1_epi32(0x80)));
+	sum = _mm_and_si128(_mm_srai_epi32(sum, 8), _mm_set1_epi32(0x1ff));
+
+	return (clamptable[_mm_cvtsi128_si32(sum)] << 24) |
+			(clamptable[_mm_extract_epi16(sum, 2)] << 16) |
+			(clamptable[_mm_extract_epi16(sum, 4)] << 8) |
+			clamptable[_mm_extract_epi16(sum, 6)];
+}
+#endif
+
+#endif // _VIDEO_RDPCOMB_H_
@@ -255,10 +255,7 @@ void n64_rdp::SpanDraw1Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 
 			userdata->NoiseColor.i.r = userdata->NoiseColor.i.g = userdata->NoiseColor.i.b = rand() << 3; // Not accurate
 
-			userdata->PixelColor.i.r = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_r[1],*userdata->ColorInputs.combiner_rgbsub_b_r[1],*userdata->ColorInputs.combiner_rgbmul_r[1],*userdata->ColorInputs.combiner_rgbadd_r[1]);
-			userdata->PixelColor.i.g = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_g[1],*userdata->ColorInputs.combiner_rgbsub_b_g[1],*userdata->ColorInputs.combiner_rgbmul_g[1],*userdata->ColorInputs.combiner_rgbadd_g[1]);
-			userdata->PixelColor.i.b = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_b[1],*userdata->ColorInputs.combiner_rgbsub_b_b[1],*userdata->ColorInputs.combiner_rgbmul_b[1],*userdata->ColorInputs.combiner_rgbadd_b[1]);
-			userdata->PixelColor.i.a = AlphaCombinerEquation(*userdata->ColorInputs.combiner_alphasub_a[1],*userdata->ColorInputs.combiner_alphasub_b[1],*userdata->ColorInputs.combiner_alphamul[1],*userdata->ColorInputs.combiner_alphaadd[1]);
+			CombinerCycle(&userdata->PixelColor, userdata->ColorInputs, 1);
 
 			//Alpha coverage combiner
 			GetAlphaCvg(&userdata->PixelColor.i.a, userdata, object);
@@ -438,42 +435,12 @@ void n64_rdp::SpanDraw2Cycle(INT32 scanline, const extent_t &extent, const rdp_p
 			//TexPipe.Cycle(&userdata->NextTexelColor, &userdata->NextTexelColor, sss, sst, tile2, 1, userdata, object, m_clamp_s_diff, m_clamp_t_diff);
 
 			userdata->NoiseColor.i.r = userdata->NoiseColor.i.g = userdata->NoiseColor.i.b = rand() << 3; // Not accurate
-			userdata->CombinedColor.i.r = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_r[0],
-																*userdata->ColorInputs.combiner_rgbsub_b_r[0],
-																*userdata->ColorInputs.combiner_rgbmul_r[0],
-																*userdata->ColorInputs.combiner_rgbadd_r[0]);
-			userdata->CombinedColor.i.g = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_g[0],
-																*userdata->ColorInputs.combiner_rgbsub_b_g[0],
-																*userdata->ColorInputs.combiner_rgbmul_g[0],
-																*userdata->ColorInputs.combiner_rgbadd_g[0]);
-			userdata->CombinedColor.i.b = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_b[0],
-																*userdata->ColorInputs.combiner_rgbsub_b_b[0],
-																*userdata->ColorInputs.combiner_rgbmul_b[0],
-																*userdata->ColorInputs.combiner_rgbadd_b[0]);
-			userdata->CombinedColor.i.a = AlphaCombinerEquation(*userdata->ColorInputs.combiner_alphasub_a[0],
-																*userdata->ColorInputs.combiner_alphasub_b[0],
-																*userdata->ColorInputs.combiner_alphamul[0],
-																*userdata->ColorInputs.combiner_alphaadd[0]);
+			CombinerCycle(&userdata->CombinedColor, userdata->ColorInputs, 0);
 
 			userdata->Texel0Color = userdata->Texel1Color;
 			userdata->Texel1Color = userdata->NextTexelColor;
 
-			userdata->PixelColor.i.r = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_r[1],
-																*userdata->ColorInputs.combiner_rgbsub_b_r[1],
-																*userdata->ColorInputs.combiner_rgbmul_r[1],
-																*userdata->ColorInputs.combiner_rgbadd_r[1]);
-			userdata->PixelColor.i.g = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_g[1],
-																*userdata->ColorInputs.combiner_rgbsub_b_g[1],
-																*userdata->ColorInputs.combiner_rgbmul_g[1],
-																*userdata->ColorInputs.combiner_rgbadd_g[1]);
-			userdata->PixelColor.i.b = ColorCombinerEquation(*userdata->ColorInputs.combiner_rgbsub_a_b[1],
-																*userdata->ColorInputs.combiner_rgbsub_b_b[1],
-																*userdata->ColorInputs.combiner_rgbmul_b[1],
-																*userdata->ColorInputs.combiner_rgbadd_b[1]);
-			userdata->PixelColor.i.a = AlphaCombinerEquation(*userdata->ColorInputs.combiner_alphasub_a[1],
-																*userdata->ColorInputs.combiner_alphasub_b[1],
-																*userdata->ColorInputs.combiner_alphamul[1],
-																*userdata->ColorInputs.combiner_alphaadd[1]);
+			CombinerCycle(&userdata->PixelColor, userdata->ColorInputs, 1);
 
 			//Alpha coverage combiner
 			GetAlphaCvg(&userdata->PixelColor.i.a, userdata, object);
@@ -62,6 +62,11 @@ UINT32 shisen_state::screen_update_sichuan2(screen_device &screen, bitmap_ind16
 	// know where it is mapped.
 	flip_screen_set(~ioport("DSW2")->read() & 1);
 
+	// the playfield is the only layer, so skip frames where none of it changed
+	screen.mark_dirty(m_bg_tilemap->screen_dirty_region(screen, cliprect));
+	m_bg_tilemap->reset_dirty_region();
+	if (!screen.update_needed(cliprect))
+		return UPDATE_HAS_NOT_CHANGED;
 
 	m_bg_tilemap->draw(screen, bitmap, cliprect, 0, 0);
 	return 0;
@@ -179,6 +179,51 @@ file_error osd_write(osd_file *file, const void *buffer, UINT64 offset, UINT32 l
 file_error osd_truncate(osd_file *file, UINT64 offset);
 
 
+/*-----------------------------------------------------------------------------
+    osd_map: map part of an open file into memory, copy-on-write
+
+    Parameters:
+
+        file - handle to a file previously opened via osd_open
+
+        offset - offset within the file of the start of the mapping
+
+        length - number of bytes to map
+
+        base - pointer to a void * to receive the address of the mapped
+            data; writes to it are private and never reach the file
+
+    Return value:
+
+        a file_error describing any error that occurred while mapping the
+        file, or FILERR_NONE if no error occurred; callers must be prepared
+        to fall back to osd_read, since mapping may be unsupported
+
+    Notes:
+
+        The mapping stays valid after the file is closed, until it is
+        released with osd_unmap.
+-----------------------------------------------------------------------------*/
+file_error osd_map(osd_file *file, UINT64 offset, UINT32 length, void **base);
+
+
+/*-----------------------------------------------------------------------------
+    osd_unmap: release a mapping made by osd_map
+
+    Parameters:
+
+        base - the address returned by osd_map
+
+        length - the length passed to osd_map
+
+    Return value:
+
+        a file_error describing any error that occurred while unmapping,
+        or FILERR_NONE if no error occurred
+-----------------------------------------------------------------------------*/
+file_error osd_unmap(void *base, UINT32 length);
+
+
 /*-----------------------------------------------------------------------------
     osd_rmfile: deletes a file
 
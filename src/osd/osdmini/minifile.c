@@ -101,6 +101,27 @@ file_error osd_write(osd_file *file, const void *buffer, UINT64 offset, UINT32 l
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 offset, UINT32 length, void **base)
+{
+	// no mapping support; callers fall back to osd_read
+	return FILERR_FAILURE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+file_error osd_unmap(void *base, UINT32 length)
+{
+	return FILERR_FAILURE;
+}
+
+
 //============================================================
 //  osd_rmfile
 //============================================================
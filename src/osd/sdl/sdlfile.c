@@ -36,6 +36,10 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#if defined(SDLMAME_UNIX) && !defined(SDLMAME_EMSCRIPTEN)
+#include <sys/mman.h>
+#define SDLMAME_HAS_MMAP    1
+#endif
 #include <stdio.h>
 #include <errno.h>
 
@@ -384,6 +388,49 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 offset, UINT32 length, void **base)
+{
+#ifdef SDLMAME_HAS_MMAP
+	if (file->type != SDLFILE_FILE || length == 0)
+		return FILERR_FAILURE;
+
+	// mmap wants a page-aligned offset
+	UINT64 pagesize = sysconf(_SC_PAGESIZE);
+	UINT32 delta = offset % pagesize;
+	void *result = mmap(NULL, length + delta, PROT_READ | PROT_WRITE, MAP_PRIVATE, file->handle, offset - delta);
+	if (result == MAP_FAILED)
+		return error_to_file_error(errno);
+
+	*base = (UINT8 *)result + delta;
+	return FILERR_NONE;
+#else
+	return FILERR_FAILURE;
+#endif
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+file_error osd_unmap(void *base, UINT32 length)
+{
+#ifdef SDLMAME_HAS_MMAP
+	FPTR pagesize = sysconf(_SC_PAGESIZE);
+	UINT32 delta = (FPTR)base % pagesize;
+	if (munmap((UINT8 *)base - delta, length + delta) != 0)
+		return error_to_file_error(errno);
+	return FILERR_NONE;
+#else
+	return FILERR_FAILURE;
+#endif
+}
+
+
 //============================================================
 //  osd_close
 //============================================================
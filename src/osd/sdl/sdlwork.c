@@ -46,6 +46,8 @@ int osd_num_processors = 0;
 
 #define ENV_PROCESSORS               "OSDPROCESSORS"
 #define ENV_WORKQUEUEMAXTHREADS      "OSDWORKQUEUEMAXTHREADS"
+#define ENV_WORKQUEUESPINTIME        "OSDWORKQUEUESPINTIME"
+#define ENV_WORKQUEUEAFFINITY        "OSDWORKQUEUEAFFINITY"
 
 #define INFINITE                (osd_ticks_per_second() *  (osd_ticks_t) 10000)
 #define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
@@ -71,12 +73,22 @@ int osd_num_processors = 0;
 //  TYPE DEFINITIONS
 //============================================================
 
+struct work_deque
+{
+	volatile INT32      lock;           // spin lock protecting the list
+	osd_work_item * volatile list;      // list of items, oldest first
+	osd_work_item **    tailptr;        // pointer to the tail pointer of the list
+	INT32               items;          // number of items in the list
+};
+
+
 struct work_thread_info
 {
 	osd_work_queue *    queue;          // pointer back to the queue
 	osd_thread *        handle;         // handle to the thread
 	osd_event *         wakeevent;      // wake event for the thread
 	volatile INT32      active;         // are we actively processing work?
+	work_deque          deque;          // work handed to this thread, which others may steal from
 
 #if KEEP_STATISTICS
 	INT32               itemsdone;
@@ -90,16 +102,16 @@ struct work_thread_info
 
 struct osd_work_queue
 {
-	osd_scalable_lock * lock;           // lock for protecting the queue
-	osd_work_item * volatile list;      // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
 	osd_work_item * volatile free;      // free list of work items
 	volatile INT32      items;          // items in the queue
 	volatile INT32      livethreads;    // number of live threads
 	volatile INT32      waiting;        // is someone waiting on the queue to complete?
 	volatile UINT8      exiting;        // should the threads exit on their next opportunity?
+	volatile INT32      nextdeque;      // rotating index of the deque that gets the next work
 	UINT32              threads;        // number of threads in this queue
+	UINT32              deques;         // number of deques work is distributed over
 	UINT32              flags;          // creation flags
+	osd_ticks_t         spintime;       // how long idle threads spin looking for work before sleeping
 	work_thread_info *  thread;         // array of thread information
 	osd_event   *       doneevent;      // event signalled when work is complete
 
@@ -108,6 +120,7 @@ struct osd_work_queue
 	volatile INT32      setevents;      // number of times we called SetEvent
 	volatile INT32      extraitems;     // how many extra items we got after the first in the queue loop
 	volatile INT32      spinloops;      // how many times spinning bought us more items
+	volatile INT32      steals;         // how many times a thread took work from another thread's deque
 #endif
 };
 
@@ -139,6 +152,27 @@ int osd_num_processors = 0;
 static int effective_num_processors(void);
 static void * worker_thread_entry(void *param);
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
+static int queue_has_work(osd_work_queue *queue);
+static void deque_append(work_deque *deque, osd_work_item *first, osd_work_item *last, INT32 count);
+static osd_work_item *deque_take(work_deque *deque, int steal);
+
+
+//============================================================
+//  INLINE FUNCTIONS
+//============================================================
+
+INLINE void deque_lock(work_deque *deque)
+{
+	while (atomic_exchange32(&deque->lock, TRUE) != FALSE)
+		while (deque->lock)
+			osd_yield_processor();
+}
+
+
+INLINE void deque_unlock(work_deque *deque)
+{
+	atomic_exchange32(&deque->lock, FALSE);
+}
 
 
 //============================================================
@@ -150,7 +184,10 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	int numprocs = effective_num_processors();
 	osd_work_queue *queue;
 	int threadnum;
-	char *osdworkqueuemaxthreads = osd_getenv("OSDWORKQUEUEMAXTHREADS");
+	char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
+	char *osdworkqueuespintime = osd_getenv(ENV_WORKQUEUESPINTIME);
+	char *osdworkqueueaffinity = osd_getenv(ENV_WORKQUEUEAFFINITY);
+	int spinmicroseconds;
 
 	// allocate a new queue
 	queue = (osd_work_queue *)osd_malloc(sizeof(*queue));
@@ -159,19 +196,18 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 	memset(queue, 0, sizeof(*queue));
 
 	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
 	queue->flags = flags;
 
+	// high frequency queues spin for a while before sleeping; the environment can override this for any queue
+	queue->spintime = (flags & WORK_QUEUE_FLAG_HIGH_FREQ) ? SPIN_LOOP_TIME : 0;
+	if (osdworkqueuespintime != NULL && sscanf(osdworkqueuespintime, "%d", &spinmicroseconds) == 1 && spinmicroseconds >= 0)
+		queue->spintime = osd_ticks_per_second() * (osd_ticks_t)spinmicroseconds / 1000000;
+
 	// allocate events for the queue
 	queue->doneevent = osd_event_alloc(TRUE, TRUE);     // manual reset, signalled
 	if (queue->doneevent == NULL)
 		goto error;
 
-	// initialize the critical section
-	queue->lock = osd_scalable_lock_alloc();
-	if (queue->lock == NULL)
-		goto error;
-
 	// determine how many threads to create...
 	// on a single-CPU system, create 1 thread for I/O queues, and 0 threads for everything else
 	if (numprocs == 1)
@@ -194,6 +230,11 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 		goto error;
 	memset(queue->thread, 0, (queue->threads + 1) * sizeof(queue->thread[0]));
 
+	// each worker thread gets a deque; with no threads, the caller processes deque 0 itself
+	queue->deques = MAX(queue->threads, 1);
+	for (threadnum = 0; threadnum <= queue->threads; threadnum++)
+		queue->thread[threadnum].deque.tailptr = (osd_work_item **)&queue->thread[threadnum].deque.list;
+
 	// iterate over threads
 	for (threadnum = 0; threadnum < queue->threads; threadnum++)
 	{
@@ -218,6 +259,10 @@ osd_work_queue *osd_work_queue_alloc(int flags)
 			osd_thread_adjust_priority(thread->handle, 1);
 		else
 			osd_thread_adjust_priority(thread->handle, 0);
+
+		// optionally pin multi queue threads to their own processors, leaving the first to the main thread
+		if ((flags & WORK_QUEUE_FLAG_MULTI) && osdworkqueueaffinity != NULL && atoi(osdworkqueueaffinity) != 0 && numprocs > 1)
+			osd_thread_cpu_affinity(thread->handle, (UINT32)1 << ((threadnum + 1) % MIN(numprocs, 32)));
 	}
 
 	// start a timer going for "waittime" on the main thread
@@ -354,10 +399,6 @@ void osd_work_queue_free(osd_work_queue *queue)
 #endif
 	}
 
-	// free the list
-	if (queue->thread != NULL)
-		osd_free(queue->thread);
-
 	// free all the events
 	if (queue->doneevent != NULL)
 		osd_event_free(queue->doneevent);
@@ -372,14 +413,20 @@ void osd_work_queue_free(osd_work_queue *queue)
 		osd_free(item);
 	}
 
-	// free all items in the active list
-	while (queue->list != NULL)
+	// free all items in the per-thread deques
+	if (queue->thread != NULL)
 	{
-		osd_work_item *item = (osd_work_item *)queue->list;
-		queue->list = item->next;
-		if (item->event != NULL)
-			osd_event_free(item->event);
-		osd_free(item);
+		int threadnum;
+
+		for (threadnum = 0; threadnum <= queue->threads; threadnum++)
+			while (queue->thread[threadnum].deque.list != NULL)
+			{
+				osd_work_item *item = queue->thread[threadnum].deque.list;
+				queue->thread[threadnum].deque.list = item->next;
+				if (item->event != NULL)
+					osd_event_free(item->event);
+				osd_free(item);
+			}
 	}
 
 #if KEEP_STATISTICS
@@ -387,9 +434,13 @@ void osd_work_queue_free(osd_work_queue *queue)
 	printf("SetEvent calls = %9d\n", queue->setevents);
 	printf("Extra items    = %9d\n", queue->extraitems);
 	printf("Spin loops     = %9d\n", queue->spinloops);
+	printf("Steals         = %9d\n", queue->steals);
 #endif
 
-	osd_scalable_lock_free(queue->lock);
+	// free the list
+	if (queue->thread != NULL)
+		osd_free(queue->thread);
+
 	// free the queue itself
 	osd_free(queue);
 }
@@ -403,22 +454,29 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 {
 	osd_work_item *itemlist = NULL, *lastitem = NULL;
 	osd_work_item **item_tailptr = &itemlist;
-	INT32 lockslot;
+	osd_work_item *freelist;
+	UINT32 dequenum;
+	INT32 chunks, chunknum;
 	int itemnum;
 
+	// grab the whole free list at once; taking it all avoids both per-item contention and ABA problems
+	do
+	{
+		freelist = (osd_work_item *)queue->free;
+	} while (freelist != NULL && compare_exchange_ptr((PVOID volatile *)&queue->free, freelist, NULL) != freelist);
+
 	// loop over items, building up a local list of work
 	for (itemnum = 0; itemnum < numitems; itemnum++)
 	{
 		osd_work_item *item;
 
 		// first allocate a new work item; try the free list first
-		do
-		{
-			item = (osd_work_item *)queue->free;
-		} while (item != NULL && compare_exchange_ptr((PVOID volatile *)&queue->free, item, item->next) != item);
+		item = freelist;
+		if (item != NULL)
+			freelist = item->next;
 
 		// if nothing, allocate something new
-		if (item == NULL)
+		else
 		{
 			// allocate the item
 			item = (osd_work_item *)osd_malloc(sizeof(*item));
@@ -443,16 +501,38 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		parambase = (UINT8 *)parambase + paramstep;
 	}
 
-	// enqueue the whole thing within the critical section
-	lockslot = osd_scalable_lock_acquire(queue->lock);
-	*queue->tailptr = itemlist;
-	queue->tailptr = item_tailptr;
-	osd_scalable_lock_release(queue->lock, lockslot);
+	// return whatever we didn't use to the free list
+	if (freelist != NULL)
+	{
+		osd_work_item *freetail = freelist, *next;
+		while (freetail->next != NULL)
+			freetail = freetail->next;
+		do
+		{
+			next = (osd_work_item *)queue->free;
+			freetail->next = next;
+		} while (compare_exchange_ptr((PVOID volatile *)&queue->free, next, freelist) != next);
+	}
 
-	// increment the number of items in the queue
+	// increment the number of items in the queue before anyone can see them
 	atomic_add32(&queue->items, numitems);
 	add_to_stat(&queue->itemsqueued, numitems);
 
+	// hand out the work in contiguous chunks, one per deque, starting where the last batch left off
+	chunks = MIN(numitems, queue->deques);
+	dequenum = (UINT32)atomic_add32(&queue->nextdeque, chunks) - chunks;
+	for (chunknum = 0; chunknum < chunks; chunknum++)
+	{
+		INT32 count = numitems / chunks + ((chunknum < numitems % chunks) ? 1 : 0);
+		osd_work_item *first = itemlist, *last = itemlist;
+
+		for (itemnum = 1; itemnum < count; itemnum++)
+			last = last->next;
+		itemlist = last->next;
+		last->next = NULL;
+		deque_append(&queue->thread[(dequenum + chunknum) % queue->deques].deque, first, last, count);
+	}
+
 	// look for free threads to do the work
 	if (queue->livethreads < queue->threads)
 	{
@@ -602,7 +682,7 @@ static void *worker_thread_entry(void *param)
 	{
 		// block waiting for work or exit
 		// bail on exit, and only wait if there are no pending items in queue
-		if (!queue->exiting && queue->list == NULL)
+		if (!queue->exiting && !queue_has_work(queue))
 		{
 			begin_timing(thread->waittime);
 			osd_event_wait(thread->wakeevent, INFINITE);
@@ -623,23 +703,23 @@ static void *worker_thread_entry(void *param)
 			// process as much as we can
 			worker_thread_process(queue, thread);
 
-			// if we're a high frequency queue, spin for a while before giving up
-			if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->list == NULL)
+			// if we're configured to spin, do so for a while before giving up
+			if (queue->spintime != 0 && !queue_has_work(queue))
 			{
 				// spin for a while looking for more work
 				begin_timing(thread->spintime);
-				stopspin = osd_ticks() + SPIN_LOOP_TIME;
+				stopspin = osd_ticks() + queue->spintime;
 
 				do {
 					int spin = 10000;
-					while (--spin && queue->list == NULL)
+					while (--spin && !queue_has_work(queue))
 						osd_yield_processor();
-				} while (queue->list == NULL && osd_ticks() < stopspin);
+				} while (!queue_has_work(queue) && osd_ticks() < stopspin);
 				end_timing(thread->spintime);
 			}
 
 			// if nothing more, release the processor
-			if (queue->list == NULL)
+			if (!queue_has_work(queue))
 				break;
 			add_to_stat(&queue->spinloops, 1);
 		}
@@ -664,31 +744,59 @@ static void *worker_thread_entry(void *param)
 static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread)
 {
 	int threadid = thread - queue->thread;
+	work_deque *mydeque = (threadid < queue->deques) ? &thread->deque : NULL;
+	osd_work_item *stolen = NULL;
 
 	begin_timing(thread->runtime);
 
 	// loop until everything is processed
-	while (queue->list != NULL)
+	for ( ;; )
 	{
-		osd_work_item *item;
-		INT32 lockslot;
+		osd_work_item *item = NULL;
 
-		// use a critical section to synchronize the removal of items
-		lockslot = osd_scalable_lock_acquire(queue->lock);
+		// finish anything we stole but couldn't put in a deque of our own
+		if (stolen != NULL)
 		{
-			// pull the item from the queue
-			item = (osd_work_item *)queue->list;
-			if (item != NULL)
+			item = stolen;
+			stolen = item->next;
+		}
+
+		// otherwise take the oldest item from our own deque
+		if (item == NULL && mydeque != NULL)
+			item = deque_take(mydeque, FALSE);
+
+		// failing that, steal half of the work queued for someone else
+		if (item == NULL)
+		{
+			int victim;
+
+			for (victim = 1; victim <= queue->deques && item == NULL; victim++)
+				if ((threadid + victim) % queue->deques != threadid)
+					item = deque_take(&queue->thread[(threadid + victim) % queue->deques].deque, TRUE);
+			if (item == NULL)
+				break;
+			add_to_stat(&queue->steals, 1);
+
+			// keep the rest where others can steal it back, if we can
+			if (item->next != NULL)
 			{
-				queue->list = item->next;
-				if (queue->list == NULL)
-					queue->tailptr = (osd_work_item **)&queue->list;
+				if (mydeque != NULL)
+				{
+					osd_work_item *last = item->next;
+					INT32 count = 1;
+					while (last->next != NULL)
+					{
+						last = last->next;
+						count++;
+					}
+					deque_append(mydeque, item->next, last, count);
+				}
+				else
+					stolen = item->next;
 			}
 		}
-		osd_scalable_lock_release(queue->lock, lockslot);
 
-		// process non-NULL items
-		if (item != NULL)
+		// process the item
 		{
 			// call the callback and stash the result
 			begin_timing(thread->actruntime);
@@ -712,7 +820,7 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 			}
 
 			// if we removed an item and there's still work to do, bump the stats
-			if (queue->list != NULL)
+			if (queue_has_work(queue))
 				add_to_stat(&queue->extraitems, 1);
 		}
 	}
@@ -727,4 +835,73 @@ static void worker_thread_process(osd_work_queue *queue, work_thread_info *threa
 	end_timing(thread->runtime);
 }
 
+
+//============================================================
+//  queue_has_work
+//============================================================
+
+static int queue_has_work(osd_work_queue *queue)
+{
+	int dequenum;
+
+	for (dequenum = 0; dequenum < queue->deques; dequenum++)
+		if (queue->thread[dequenum].deque.list != NULL)
+			return TRUE;
+	return FALSE;
+}
+
+
+//============================================================
+//  deque_append
+//============================================================
+
+static void deque_append(work_deque *deque, osd_work_item *first, osd_work_item *last, INT32 count)
+{
+	last->next = NULL;
+	deque_lock(deque);
+	*deque->tailptr = first;
+	deque->tailptr = &last->next;
+	deque->items += count;
+	deque_unlock(deque);
+}
+
+
+//============================================================
+//  deque_take - take the oldest item from a deque;
+//  thieves take the oldest half instead, so that
+//  they come back less often
+//============================================================
+
+static osd_work_item *deque_take(work_deque *deque, int steal)
+{
+	osd_work_item *first, *last;
+	INT32 count, itemnum;
+
+	// check without the lock first
+	if (deque->list == NULL)
+		return NULL;
+
+	deque_lock(deque);
+	first = deque->list;
+	if (first == NULL)
+	{
+		deque_unlock(deque);
+		return NULL;
+	}
+
+	// detach the chain from the front of the list
+	count = steal ? (deque->items + 1) / 2 : 1;
+	last = first;
+	for (itemnum = 1; itemnum < count; itemnum++)
+		last = last->next;
+	deque->list = last->next;
+	if (deque->list == NULL)
+		deque->tailptr = (osd_work_item **)&deque->list;
+	deque->items -= count;
+	deque_unlock(deque);
+
+	last->next = NULL;
+	return first;
+}
+
 #endif // SDLMAME_NOASM
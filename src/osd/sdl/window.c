@@ -1002,6 +1002,15 @@ void sdlwindow_video_window_update(running_machine &machine, sdl_window_info *wi
 			// ensure the target bounds are up-to-date, and then get the primitives
 			primlist = &window->get_primitives(window);
 
+			// if nothing changed since the last frame, leave the previous one on screen
+			// (unless we rely on the redraw to sync to the refresh rate); the wait
+			// above consumed the event and no draw will signal it, so do it here
+			if (primlist->unchanged() && !(video_config.waitvsync && video_config.syncrefresh))
+			{
+				osd_event_set(window->rendered_event);
+				return;
+			}
+
 			// and redraw now
 
 			wp.list = primlist;
@@ -657,14 +657,16 @@ void shaders::remove_render_target(render_target *rt)
 		}
 
 		int screen_index = rt->screen_index;
-		int other_page = 1 - rt->page_index;
+		int page_index = rt->page_index;
 		int width = rt->width;
 		int height = rt->height;
 
 		global_free(rt);
 
-		// Remove other double-buffered page (if it exists)
-		remove_render_target(width, height, screen_index, other_page);
+		// Remove the screen's other buffered pages (if they exist)
+		for (int other_page = 0; other_page < 4; other_page++)
+			if (other_page != page_index)
+				remove_render_target(width, height, screen_index, other_page);
 	}
 }
 
@@ -1260,8 +1262,8 @@ render_target* shaders::find_render_target(texture_info *info)
 {
 	render_target *curr = targethead;
 	UINT32 screen_index_data = (UINT32)info->get_texinfo().osddata;
-	UINT32 screen_index = screen_index_data >> 1;
-	UINT32 page_index = screen_index_data & 1;
+	UINT32 screen_index = screen_index_data >> 2;
+	UINT32 page_index = screen_index_data & 3;
 
 	while (curr != NULL && (curr->screen_index != screen_index || curr->page_index != page_index ||
 		curr->width != info->get_texinfo().width || curr->height != info->get_texinfo().height))
@@ -2111,8 +2113,8 @@ bool shaders::add_render_target(renderer* d3d, texture_info* info, int width, in
 		}
 
 		UINT32 screen_index_data = (UINT32)info->get_texinfo().osddata;
-		screen_index = screen_index_data >> 1;
-		page_index = screen_index_data & 1;
+		screen_index = screen_index_data >> 2;
+		page_index = screen_index_data & 3;
 	}
 	else
 	{
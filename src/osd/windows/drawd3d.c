@@ -584,10 +584,10 @@ texture_info *texture_manager::find_texinfo(const render_texinfo *texinfo, UINT3
 	// find a match
 	for (texture = m_renderer->get_texture_manager()->get_texlist(); texture != NULL; texture = texture->get_next())
 	{
-		UINT32 test_screen = (UINT32)texture->get_texinfo().osddata >> 1;
-		UINT32 test_page = (UINT32)texture->get_texinfo().osddata & 1;
-		UINT32 prim_screen = (UINT32)texinfo->osddata >> 1;
-		UINT32 prim_page = (UINT32)texinfo->osddata & 1;
+		UINT32 test_screen = (UINT32)texture->get_texinfo().osddata >> 2;
+		UINT32 test_page = (UINT32)texture->get_texinfo().osddata & 3;
+		UINT32 prim_screen = (UINT32)texinfo->osddata >> 2;
+		UINT32 prim_page = (UINT32)texinfo->osddata & 3;
 		if (test_screen != prim_screen || test_page != prim_page)
 		{
 			continue;
@@ -622,13 +622,13 @@ texture_info *texture_manager::find_texinfo(const render_texinfo *texinfo, UINT3
 			return NULL;
 		}
 
-		UINT32 prim_screen = texinfo->osddata >> 1;
-		UINT32 prim_page = texinfo->osddata & 1;
+		UINT32 prim_screen = texinfo->osddata >> 2;
+		UINT32 prim_page = texinfo->osddata & 3;
 
 		for (texture = m_renderer->get_texture_manager()->get_texlist(); texture != NULL; texture = texture->get_next())
 		{
-			UINT32 test_screen = texture->get_texinfo().osddata >> 1;
-			UINT32 test_page = texture->get_texinfo().osddata & 1;
+			UINT32 test_screen = texture->get_texinfo().osddata >> 2;
+			UINT32 test_page = texture->get_texinfo().osddata & 3;
 			if (test_screen != prim_screen || test_page != prim_page)
 			{
 				continue;
@@ -275,6 +275,51 @@ file_error osd_truncate(osd_file *file, UINT64 offset)
 }
 
 
+//============================================================
+//  osd_map
+//============================================================
+
+file_error osd_map(osd_file *file, UINT64 offset, UINT32 length, void **base)
+{
+	if (file->type != WINFILE_FILE || length == 0)
+		return FILERR_FAILURE;
+
+	// views must start on an allocation granularity boundary
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	UINT32 delta = offset % info.dwAllocationGranularity;
+	offset -= delta;
+
+	// the view keeps the mapping object alive once the handle is closed
+	HANDLE mapping = CreateFileMapping(file->handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if (mapping == NULL)
+		return win_error_to_mame_file_error(GetLastError());
+	void *result = MapViewOfFile(mapping, FILE_MAP_COPY, (DWORD)(offset >> 32), (DWORD)offset, length + delta);
+	DWORD error = GetLastError();
+	CloseHandle(mapping);
+	if (result == NULL)
+		return win_error_to_mame_file_error(error);
+
+	*base = (UINT8 *)result + delta;
+	return FILERR_NONE;
+}
+
+
+//============================================================
+//  osd_unmap
+//============================================================
+
+file_error osd_unmap(void *base, UINT32 length)
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	UINT32 delta = (FPTR)base % info.dwAllocationGranularity;
+	if (!UnmapViewOfFile((UINT8 *)base - delta))
+		return win_error_to_mame_file_error(GetLastError());
+	return FILERR_NONE;
+}
+
+
 //============================================================
 //  osd_close
 //============================================================
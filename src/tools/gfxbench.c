@@ -0,0 +1,329 @@
+/***************************************************************************
+
+    gfxbench.c
+
+    Times each drawgfx variant that has a span operation, drawing the
+    same list of unflipped sprites once through the PIXEL_OP loop alone
+    and once through the span operation, and checks that both leave
+    the destination and priority bitmaps identical.
+
+****************************************************************************/
+
+/* this tool doesn't link the emulator core, so it always uses the
+   dummy profiler that the drawgfx cores bracket themselves with */
+#undef MAME_PROFILER
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "emucore.h"
+#include "eminline.h"
+#include "profiler.h"
+#include "drawgfxm.h"
+
+#define DEFAULT_DRAWS           20000
+#define DEFAULT_SIZE            16
+#define DEFAULT_PASSES          5
+#define BITMAP_WIDTH            384
+#define BITMAP_HEIGHT           256
+#define NUM_ELEMENTS            256
+#define TRANS_PEN               0
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct draw_params
+{
+	UINT32              code;                   /* element to draw */
+	UINT32              color;                  /* colour base or palette offset */
+	INT32               destx, desty;           /* top-left position */
+	UINT32              pmask;                  /* priority mask */
+};
+
+
+/* stands in for gfx_element, supplying what DRAWGFX_CORE_SPAN uses */
+class bench_gfx
+{
+public:
+	bench_gfx(int size);
+	~bench_gfx() { delete[] m_data; }
+
+	UINT16 width() const { return m_size; }
+	UINT16 height() const { return m_size; }
+	UINT32 elements() const { return NUM_ELEMENTS; }
+	UINT32 rowbytes() const { return m_size; }
+	const UINT8 *get_data(UINT32 code) const { return m_data + code * m_size * m_size; }
+
+	void opaque16(bitmap_ind16 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span);
+	void transpen16(bitmap_ind16 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span);
+	void transpen32(bitmap_rgb32 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span);
+	void prio_transpen16(bitmap_ind16 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span);
+	void prio_transpen32(bitmap_rgb32 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span);
+
+private:
+	int                 m_size;
+	UINT8 *             m_data;
+};
+
+
+struct bench_variant
+{
+	const char *        name;                   /* variant name */
+	bool                rgb32;                  /* true to draw to the 32bpp bitmap */
+	void                (bench_gfx::*draw16)(bitmap_ind16 &, bitmap_ind8 &, const draw_params &, const pen_t *, bool);
+	void                (bench_gfx::*draw32)(bitmap_rgb32 &, bitmap_ind8 &, const draw_params &, const pen_t *, bool);
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+profiler_state g_profiler;
+bitmap_ind8 drawgfx_dummy_priority_bitmap;
+
+static UINT32 random_state = 0x12345678;
+
+static const bench_variant variants[] =
+{
+	{ "opaque 16bpp",          false, &bench_gfx::opaque16, NULL },
+	{ "transpen 16bpp",        false, &bench_gfx::transpen16,        NULL },
+	{ "transpen 32bpp",        true,  NULL,                          &bench_gfx::transpen32 },
+	{ "prio_transpen 16bpp",   false, &bench_gfx::prio_transpen16,   NULL },
+	{ "prio_transpen 32bpp",   true,  NULL,                          &bench_gfx::prio_transpen32 },
+};
+
+
+
+/***************************************************************************
+    DRAWING
+***************************************************************************/
+
+dummy_profiler_state::dummy_profiler_state()
+{
+}
+
+
+/*-------------------------------------------------
+    random_value - return a random value below
+    'range'
+-------------------------------------------------*/
+
+static UINT32 random_value(UINT32 range)
+{
+	random_state = random_state * 1664525 + 1013904223;
+	return (random_state >> 8) % range;
+}
+
+
+/*-------------------------------------------------
+    bench_gfx - build sprite-like elements: a
+    mix of solid runs, scattered transparent
+    pens and fully transparent rows
+-------------------------------------------------*/
+
+bench_gfx::bench_gfx(int size)
+	: m_size(size),
+		m_data(new UINT8[NUM_ELEMENTS * size * size])
+{
+	for (int code = 0; code < NUM_ELEMENTS; code++)
+		for (int y = 0; y < size; y++)
+		{
+			UINT8 *row = m_data + (code * size + y) * size;
+			int style = random_value(4);
+			for (int x = 0; x < size; x++)
+			{
+				UINT8 pen = 1 + random_value(255);
+				if (style == 0 || (style == 1 && random_value(3) == 0))
+					pen = TRANS_PEN;
+				row[x] = pen;
+			}
+		}
+}
+
+
+/*
+    Each variant sets up the locals its PIXEL_OP and SPAN_OP use the
+    way the matching gfx_element function in drawgfx.c does, then
+    expands the core either without or with the span operation.
+*/
+
+#define BENCH_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, SPAN_OP)                        \
+do {                                                                                    \
+	UINT32 code = params.code;                                                          \
+	UINT32 color = params.color;                                                        \
+	INT32 destx = params.destx, desty = params.desty;                                   \
+	UINT32 pmask = params.pmask | (1U << 31);                                           \
+	UINT32 trans_pen = TRANS_PEN;                                                       \
+	const rectangle &cliprect = dest.cliprect();                                        \
+	int flipx = 0, flipy = 0;                                                           \
+	(void)pmask; (void)trans_pen; (void)paldata; (void)color;                           \
+	if (span)                                                                           \
+		DRAWGFX_CORE_SPAN(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, SPAN_OP);                \
+	else                                                                                \
+		DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE);                              \
+} while (0)
+
+void bench_gfx::opaque16(bitmap_ind16 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span)
+{
+	BENCH_CORE(UINT16, PIXEL_OP_REBASE_OPAQUE, NO_PRIORITY, SPAN_OP_REBASE_OPAQUE16);
+}
+
+void bench_gfx::transpen16(bitmap_ind16 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span)
+{
+	BENCH_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, SPAN_OP_REBASE_TRANSPEN16);
+}
+
+void bench_gfx::transpen32(bitmap_rgb32 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span)
+{
+	paldata += params.color;
+	BENCH_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY, SPAN_OP_REMAP_TRANSPEN32);
+}
+
+void bench_gfx::prio_transpen16(bitmap_ind16 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span)
+{
+	BENCH_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8, SPAN_OP_REBASE_TRANSPEN16_PRIORITY);
+}
+
+void bench_gfx::prio_transpen32(bitmap_rgb32 &dest, bitmap_ind8 &priority, const draw_params &params, const pen_t *paldata, bool span)
+{
+	paldata += params.color;
+	BENCH_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8, SPAN_OP_REMAP_TRANSPEN32_PRIORITY);
+}
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    run_variant - reset the bitmaps and draw
+    every sprite in the list with one variant,
+    returning the elapsed ticks
+-------------------------------------------------*/
+
+static osd_ticks_t run_variant(bench_gfx &gfx, const bench_variant &variant, const draw_params *draws, int numdraws, const pen_t *paldata, bool span,
+		UINT32 *dest, const UINT32 *initdest, UINT8 *pri, const UINT8 *initpri)
+{
+	memcpy(dest, initdest, BITMAP_WIDTH * BITMAP_HEIGHT * sizeof(dest[0]));
+	memcpy(pri, initpri, BITMAP_WIDTH * BITMAP_HEIGHT);
+	bitmap_ind16 dest16((UINT16 *)dest, BITMAP_WIDTH, BITMAP_HEIGHT, BITMAP_WIDTH);
+	bitmap_rgb32 dest32(dest, BITMAP_WIDTH, BITMAP_HEIGHT, BITMAP_WIDTH);
+	bitmap_ind8 priority(pri, BITMAP_WIDTH, BITMAP_HEIGHT, BITMAP_WIDTH);
+
+	osd_ticks_t start = osd_ticks();
+	if (variant.rgb32)
+		for (int drawnum = 0; drawnum < numdraws; drawnum++)
+			(gfx.*variant.draw32)(dest32, priority, draws[drawnum], paldata, span);
+	else
+		for (int drawnum = 0; drawnum < numdraws; drawnum++)
+			(gfx.*variant.draw16)(dest16, priority, draws[drawnum], paldata, span);
+	return osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int numdraws = DEFAULT_DRAWS;
+	int size = DEFAULT_SIZE;
+	int passes = DEFAULT_PASSES;
+	int argnum;
+
+	/* parse options */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-draws") == 0 && argnum + 1 < argc)
+			numdraws = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-size") == 0 && argnum + 1 < argc)
+			size = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-passes") == 0 && argnum + 1 < argc)
+			passes = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc || numdraws < 1 || size < 1 || size > 256 || passes < 1)
+	{
+		fprintf(stderr, "Usage:\n  gfxbench [-draws <n>] [-size <pixels>] [-passes <n>]\n");
+		return 1;
+	}
+#if !DRAWGFX_SSE2
+	printf("SSE2 spans not compiled in; both paths run the PIXEL_OP loop\n");
+#endif
+
+	/* build the elements, the palette, the starting bitmaps and the sprite list */
+	bench_gfx gfx(size);
+	pen_t *paldata = new pen_t[0x10000];
+	for (int pen = 0; pen < 0x10000; pen++)
+		paldata[pen] = (random_value(0x10000) << 16) | random_value(0x10000);
+
+	UINT32 *initdest = new UINT32[BITMAP_WIDTH * BITMAP_HEIGHT];
+	UINT8 *initpri = new UINT8[BITMAP_WIDTH * BITMAP_HEIGHT];
+	for (int pixnum = 0; pixnum < BITMAP_WIDTH * BITMAP_HEIGHT; pixnum++)
+	{
+		static const UINT8 levels[] = { 0, 0, 1, 2, 4, 8, 16, 0x82 };
+		initdest[pixnum] = (random_value(0x10000) << 16) | random_value(0x10000);
+		initpri[pixnum] = levels[random_value(ARRAY_LENGTH(levels))];
+	}
+
+	draw_params *draws = new draw_params[numdraws];
+	for (int drawnum = 0; drawnum < numdraws; drawnum++)
+	{
+		static const UINT32 pmasks[] = { 0x00, 0xf0, 0xfc, 0xfe, 0xaaaa, 0xff00ff00 };
+		draws[drawnum].code = random_value(NUM_ELEMENTS);
+		draws[drawnum].color = random_value(0x100) * 0x100;
+		draws[drawnum].destx = (INT32)random_value(BITMAP_WIDTH + size) - size;
+		draws[drawnum].desty = (INT32)random_value(BITMAP_HEIGHT + size) - size;
+		draws[drawnum].pmask = pmasks[random_value(ARRAY_LENGTH(pmasks))];
+	}
+
+	UINT32 *pixeldest = new UINT32[BITMAP_WIDTH * BITMAP_HEIGHT];
+	UINT32 *spandest = new UINT32[BITMAP_WIDTH * BITMAP_HEIGHT];
+	UINT8 *pixelpri = new UINT8[BITMAP_WIDTH * BITMAP_HEIGHT];
+	UINT8 *spanpri = new UINT8[BITMAP_WIDTH * BITMAP_HEIGHT];
+
+	/* report */
+	printf("%d draws of %dx%d elements, best of %d passes\n", numdraws, size, size, passes);
+	printf("variant               PIXEL_OP Mpix/s   span Mpix/s   speedup   result\n");
+	bool failed = false;
+	for (int varnum = 0; varnum < ARRAY_LENGTH(variants); varnum++)
+	{
+		const bench_variant &variant = variants[varnum];
+		osd_ticks_t pixelbest = ~(osd_ticks_t)0, spanbest = ~(osd_ticks_t)0;
+		for (int pass = 0; pass < passes; pass++)
+		{
+			osd_ticks_t pixelticks = run_variant(gfx, variant, draws, numdraws, paldata, false, pixeldest, initdest, pixelpri, initpri);
+			osd_ticks_t spanticks = run_variant(gfx, variant, draws, numdraws, paldata, true, spandest, initdest, spanpri, initpri);
+			pixelbest = MIN(pixelbest, pixelticks);
+			spanbest = MIN(spanbest, spanticks);
+		}
+
+		/* 16bpp variants only touch the first half of the destination buffer */
+		int destbytes = BITMAP_WIDTH * BITMAP_HEIGHT * (variant.rgb32 ? 4 : 2);
+		bool match = (memcmp(pixeldest, spandest, destbytes) == 0 && memcmp(pixelpri, spanpri, BITMAP_WIDTH * BITMAP_HEIGHT) == 0);
+		if (!match)
+			failed = true;
+
+		double pixels = (double)numdraws * size * size * osd_ticks_per_second() / 1e6;
+		printf("%-20s  %15.1f  %12.1f  %7.2fx   %s\n", variant.name, pixels / (double)MAX(pixelbest, 1), pixels / (double)MAX(spanbest, 1),
+				(double)pixelbest / (double)MAX(spanbest, 1), match ? "match" : "MISMATCH");
+	}
+
+	delete[] spanpri;
+	delete[] pixelpri;
+	delete[] spandest;
+	delete[] pixeldest;
+	delete[] draws;
+	delete[] initpri;
+	delete[] initdest;
+	delete[] paldata;
+	return failed ? 1 : 0;
+}
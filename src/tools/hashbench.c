@@ -0,0 +1,222 @@
+/***************************************************************************
+
+    hashbench.c
+
+    Times CRC-32 and SHA-1 over buffers of several sizes through the
+    portable code and through the accelerated paths in hashing.c and
+    sha1.c (PCLMULQDQ and the SHA extensions, used when the CPU has
+    them), and checks that both give the same digests, including when
+    the data is misaligned and appended in uneven pieces.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "osdcore.h"
+#include "hashing.h"
+#include "sha1.h"
+
+#define DEFAULT_TOTAL           (256 * 1024 * 1024)
+#define DEFAULT_PASSES          3
+#define MAX_SIZE                (16 * 1024 * 1024)
+#define NUM_SPLIT_CHECKS        1000
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static UINT32 random_state = 0x12345678;
+
+
+
+/***************************************************************************
+    HASH WRAPPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    random_value - return a random value below
+    'range'
+-------------------------------------------------*/
+
+static UINT32 random_value(UINT32 range)
+{
+	random_state = random_state * 1664525 + 1013904223;
+	return (random_state >> 8) % range;
+}
+
+
+/*-------------------------------------------------
+    crc32_portable/crc32_accelerated - CRC-32 of
+    a buffer through zlib alone, which is what
+    crc32_creator falls back to, and through
+    crc32_creator
+-------------------------------------------------*/
+
+static UINT32 crc32_portable(const UINT8 *data, UINT32 length)
+{
+	return crc32(0, data, length);
+}
+
+static UINT32 crc32_accelerated(const UINT8 *data, UINT32 length)
+{
+	return crc32_creator::simple(data, length);
+}
+
+
+/*-------------------------------------------------
+    sha1_checksum - SHA-1 of a buffer, folded to
+    32 bits for reporting; the full digest is
+    returned in 'digest'
+-------------------------------------------------*/
+
+static UINT32 sha1_checksum(const UINT8 *data, UINT32 length, bool accelerated, UINT8 *digest)
+{
+	struct sha1_ctx ctx;
+	sha1_set_accelerated(accelerated);
+	sha1_init(&ctx);
+	sha1_update(&ctx, length, data);
+	sha1_final(&ctx);
+	sha1_digest(&ctx, SHA1_DIGEST_SIZE, digest);
+	sha1_set_accelerated(true);
+	return (digest[0] << 24) | (digest[1] << 16) | (digest[2] << 8) | digest[3];
+}
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    check_splits - hash random misaligned pieces
+    of the buffer both ways, appending them in
+    uneven chunks to the accelerated hashers,
+    and return the number of mismatches
+-------------------------------------------------*/
+
+static int check_splits(const UINT8 *buffer)
+{
+	int mismatches = 0;
+	for (int checknum = 0; checknum < NUM_SPLIT_CHECKS; checknum++)
+	{
+		UINT32 offset = random_value(64);
+		UINT32 length = random_value(4096 + 1);
+		const UINT8 *data = buffer + offset;
+
+		crc32_creator crc;
+		sha1_creator sha1;
+		for (UINT32 done = 0; done < length; )
+		{
+			UINT32 chunk = random_value(300) + 1;
+			chunk = MIN(chunk, length - done);
+			crc.append(data + done, chunk);
+			sha1.append(data + done, chunk);
+			done += chunk;
+		}
+
+		UINT8 digest[SHA1_DIGEST_SIZE];
+		sha1_checksum(data, length, false, digest);
+		if (UINT32(crc.finish()) != crc32_portable(data, length) || memcmp(sha1.finish().m_raw, digest, SHA1_DIGEST_SIZE) != 0)
+		{
+			if (mismatches++ < 5)
+				fprintf(stderr, "Mismatch hashing %d bytes at offset %d in pieces\n", length, offset);
+		}
+	}
+	return mismatches;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	static const UINT32 sizes[] = { 64, 256, 4096, 65536, 1024 * 1024, MAX_SIZE };
+	UINT32 total = DEFAULT_TOTAL;
+	int passes = DEFAULT_PASSES;
+	int argnum;
+
+	/* parse options */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-total") == 0 && argnum + 1 < argc)
+			total = atoi(argv[++argnum]) * 1024 * 1024;
+		else if (strcmp(argv[argnum], "-passes") == 0 && argnum + 1 < argc)
+			passes = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc || total < 1 || passes < 1)
+	{
+		fprintf(stderr, "Usage:\n  hashbench [-total <MB per size>] [-passes <n>]\n");
+		return 1;
+	}
+
+	/* fill a buffer with slack so that every size can also be hashed misaligned */
+	UINT8 *buffer = new UINT8[MAX_SIZE + 64];
+	for (int index = 0; index < MAX_SIZE + 64; index++)
+		buffer[index] = random_value(256);
+
+	/* report */
+	printf("%d MB hashed per size and path, best of %d passes; offsets alternate 0 and 1\n", total / (1024 * 1024), passes);
+	printf("    size   CRC-32 zlib MB/s   accelerated MB/s   SHA-1 portable MB/s   accelerated MB/s\n");
+	int mismatches = 0;
+	for (int sizenum = 0; sizenum < ARRAY_LENGTH(sizes); sizenum++)
+	{
+		UINT32 size = sizes[sizenum];
+		UINT32 count = MAX(total / size, 1);
+		osd_ticks_t best[4] = { ~(osd_ticks_t)0, ~(osd_ticks_t)0, ~(osd_ticks_t)0, ~(osd_ticks_t)0 };
+		UINT32 checksum[4] = { 0 };
+
+		for (int pass = 0; pass < passes; pass++)
+			for (int path = 0; path < 4; path++)
+			{
+				UINT8 digest[SHA1_DIGEST_SIZE];
+				checksum[path] = 0;
+				osd_ticks_t start = osd_ticks();
+				for (UINT32 index = 0; index < count; index++)
+				{
+					const UINT8 *data = buffer + (index & 1);
+					switch (path)
+					{
+						case 0:     checksum[path] += crc32_portable(data, size);              break;
+						case 1:     checksum[path] += crc32_accelerated(data, size);           break;
+						case 2:     checksum[path] += sha1_checksum(data, size, false, digest); break;
+						case 3:     checksum[path] += sha1_checksum(data, size, true, digest);  break;
+					}
+				}
+				osd_ticks_t elapsed = osd_ticks() - start;
+				best[path] = MIN(best[path], elapsed);
+			}
+
+		/* compare full digests at both offsets, then the sums of everything timed */
+		bool differ = (checksum[0] != checksum[1] || checksum[2] != checksum[3]);
+		for (int offset = 0; offset < 2; offset++)
+		{
+			UINT8 portable[SHA1_DIGEST_SIZE], accelerated[SHA1_DIGEST_SIZE];
+			sha1_checksum(buffer + offset, size, false, portable);
+			sha1_checksum(buffer + offset, size, true, accelerated);
+			if (crc32_portable(buffer + offset, size) != crc32_accelerated(buffer + offset, size) || memcmp(portable, accelerated, SHA1_DIGEST_SIZE) != 0)
+				differ = true;
+		}
+		if (differ)
+		{
+			fprintf(stderr, "Mismatch hashing %d byte buffers\n", size);
+			mismatches++;
+		}
+
+		double megabytes = (double)count * size * osd_ticks_per_second() / (1024.0 * 1024.0);
+		printf("%8d  %17.0f  %17.0f  %20.0f  %17.0f\n", size, megabytes / (double)MAX(best[0], 1), megabytes / (double)MAX(best[1], 1),
+				megabytes / (double)MAX(best[2], 1), megabytes / (double)MAX(best[3], 1));
+	}
+
+	mismatches += check_splits(buffer);
+	printf("%s\n", (mismatches == 0) ? "All digests match" : "DIGESTS DIFFER");
+	delete[] buffer;
+	return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/***************************************************************************
+
+    rdpbench.c
+
+    Checks that the reduced form of the N64 RDP colour combiner cycle
+    in rdpcomb.h, which the span renderers use, and its SSE2 form both
+    match the full combiner equations bit for bit, and times all three.
+    Every channel is driven through all 2^24 combinations of the 8-bit
+    a, b and c inputs, with d chosen at random.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "video/rdpcomb.h"
+
+#define NUM_COMBINATIONS        (1 << 24)
+#define BLOCK_INPUTS            (1 << 16)
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct combiner_input
+{
+	UINT8               a[4];                   /* subtract A inputs, R/G/B/alpha */
+	UINT8               b[4];                   /* subtract B inputs */
+	UINT8               c[4];                   /* multiply inputs */
+	UINT8               d[4];                   /* add inputs */
+};
+
+typedef UINT32 (*combiner_cycle)(INT32, INT32, INT32, INT32, INT32, INT32, INT32, INT32,
+		INT32, INT32, INT32, INT32, INT32, INT32, INT32, INT32, const UINT32 *);
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static UINT32 clamptable[0x200];
+static UINT32 random_state = 0x12345678;
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    build_clamptable - build the table the way
+    n64_rdp does
+-------------------------------------------------*/
+
+static void build_clamptable(void)
+{
+	for (int i = 0; i < 0x200; i++)
+		switch ((i >> 7) & 3)
+		{
+			case 0:
+			case 1:     clamptable[i] = i & 0xff;   break;
+			case 2:     clamptable[i] = 0xff;       break;
+			case 3:     clamptable[i] = 0;          break;
+		}
+}
+
+
+/*-------------------------------------------------
+    generate_block - fill a block of inputs,
+    giving each channel its own walk through the
+    a/b/c combinations
+-------------------------------------------------*/
+
+static void generate_block(combiner_input *inputs, UINT32 first, int count)
+{
+	for (int index = 0; index < count; index++)
+		for (int chan = 0; chan < 4; chan++)
+		{
+			UINT32 combo = (first + index + chan * 0x555555) & (NUM_COMBINATIONS - 1);
+			random_state = random_state * 1664525 + 1013904223;
+			inputs[index].a[chan] = combo;
+			inputs[index].b[chan] = combo >> 8;
+			inputs[index].c[chan] = combo >> 16;
+			inputs[index].d[chan] = random_state >> 24;
+		}
+}
+
+
+/*-------------------------------------------------
+    time_block - run one form over a block of
+    inputs, storing each result
+-------------------------------------------------*/
+
+template<combiner_cycle _Cycle>
+static osd_ticks_t time_block(const combiner_input *inputs, int count, UINT32 *results)
+{
+	osd_ticks_t start = osd_ticks();
+	for (int index = 0; index < count; index++)
+	{
+		const combiner_input &in = inputs[index];
+		results[index] = (*_Cycle)(in.a[0], in.a[1], in.a[2], in.a[3], in.b[0], in.b[1], in.b[2], in.b[3],
+				in.c[0], in.c[1], in.c[2], in.c[3], in.d[0], in.d[1], in.d[2], in.d[3], clamptable);
+	}
+	return osd_ticks() - start;
+}
+
+
+/*-------------------------------------------------
+    wrappers with external linkage, so that they
+    can be template arguments
+-------------------------------------------------*/
+
+UINT32 cycle_equations(INT32 ar, INT32 ag, INT32 ab, INT32 aa, INT32 br, INT32 bg, INT32 bb, INT32 ba,
+		INT32 cr, INT32 cg, INT32 cb, INT32 ca, INT32 dr, INT32 dg, INT32 db, INT32 da, const UINT32 *table)
+{
+	return rdp_combiner_cycle_equations(ar, ag, ab, aa, br, bg, bb, ba, cr, cg, cb, ca, dr, dg, db, da, table);
+}
+
+UINT32 cycle_reduced(INT32 ar, INT32 ag, INT32 ab, INT32 aa, INT32 br, INT32 bg, INT32 bb, INT32 ba,
+		INT32 cr, INT32 cg, INT32 cb, INT32 ca, INT32 dr, INT32 dg, INT32 db, INT32 da, const UINT32 *table)
+{
+	return rdp_combiner_cycle(ar, ag, ab, aa, br, bg, bb, ba, cr, cg, cb, ca, dr, dg, db, da, table);
+}
+
+#ifdef RDP_COMBINER_SSE2
+UINT32 cycle_sse2(INT32 ar, INT32 ag, INT32 ab, INT32 aa, INT32 br, INT32 bg, INT32 bb, INT32 ba,
+		INT32 cr, INT32 cg, INT32 cb, INT32 ca, INT32 dr, INT32 dg, INT32 db, INT32 da, const UINT32 *table)
+{
+	return rdp_combiner_cycle_sse2(ar, ag, ab, aa, br, bg, bb, ba, cr, cg, cb, ca, dr, dg, db, da, table);
+}
+#endif
+
+static const struct
+{
+	const char *        name;                   /* form name */
+	osd_ticks_t         (*time)(const combiner_input *inputs, int count, UINT32 *results);
+} forms[] =
+{
+	{ "equations",  time_block<cycle_equations> },
+	{ "reduced",    time_block<cycle_reduced> },
+#ifdef RDP_COMBINER_SSE2
+	{ "SSE2",       time_block<cycle_sse2> },
+#endif
+};
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1)
+	{
+		fprintf(stderr, "Usage:\n  rdpbench\n");
+		return 1;
+	}
+
+	build_clamptable();
+	combiner_input *inputs = new combiner_input[BLOCK_INPUTS];
+	UINT32 *results[ARRAY_LENGTH(forms)];
+	osd_ticks_t ticks[ARRAY_LENGTH(forms)];
+	int mismatches[ARRAY_LENGTH(forms)];
+	for (int formnum = 0; formnum < ARRAY_LENGTH(forms); formnum++)
+	{
+		results[formnum] = new UINT32[BLOCK_INPUTS];
+		ticks[formnum] = 0;
+		mismatches[formnum] = 0;
+	}
+
+	/* time every form over the same block, then compare each with the equations */
+	for (UINT32 first = 0; first < NUM_COMBINATIONS; first += BLOCK_INPUTS)
+	{
+		generate_block(inputs, first, BLOCK_INPUTS);
+		for (int formnum = 0; formnum < ARRAY_LENGTH(forms); formnum++)
+			ticks[formnum] += (*forms[formnum].time)(inputs, BLOCK_INPUTS, results[formnum]);
+		for (int formnum = 1; formnum < ARRAY_LENGTH(forms); formnum++)
+			for (int index = 0; index < BLOCK_INPUTS; index++)
+				if (results[formnum][index] != results[0][index] && mismatches[formnum]++ < 5)
+					fprintf(stderr, "%s: %08X vs %08X (a=%d b=%d c=%d d=%d)\n", forms[formnum].name, results[formnum][index], results[0][index],
+							inputs[index].a[0], inputs[index].b[0], inputs[index].c[0], inputs[index].d[0]);
+	}
+
+	/* report */
+	int failures = 0;
+	double basens = (double)ticks[0] * 1e9 / (double)osd_ticks_per_second() / (double)NUM_COMBINATIONS;
+	printf("%d cycles per form\n", NUM_COMBINATIONS);
+	for (int formnum = 0; formnum < ARRAY_LENGTH(forms); formnum++)
+	{
+		double ns = (double)ticks[formnum] * 1e9 / (double)osd_ticks_per_second() / (double)NUM_COMBINATIONS;
+		printf("%-10s %6.2f ns (%.2fx), %d mismatches\n", forms[formnum].name, ns, basens / ns, mismatches[formnum]);
+		failures += mismatches[formnum];
+		delete[] results[formnum];
+	}
+#ifndef RDP_COMBINER_SSE2
+	printf("SSE2 form not compiled in\n");
+#endif
+
+	delete[] inputs;
+	return (failures == 0) ? 0 : 1;
+}
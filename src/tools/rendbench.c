@@ -0,0 +1,266 @@
+/***************************************************************************
+
+    rendbench.c
+
+    Times the bilinear artwork resampler from rendsamp.h through the
+    scalar, SSE2 and AVX2 kernels (the latter when the CPU has it) on
+    a few typical upscales, and checks that every kernel produces the
+    same output as the scalar one, bit for bit, over those and a run
+    of random sizes and colors.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "rendsamp.h"
+
+#define DEFAULT_PASSES          5
+#define NUM_RANDOM_CHECKS       500
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+typedef void (*resample_func)(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy);
+
+struct resample_kernel
+{
+	const char *        name;                   /* kernel name */
+	resample_func       func;                   /* kernel */
+	bool                (*available)(void);     /* true if the CPU can run it */
+};
+
+struct resample_size
+{
+	UINT32              swidth, sheight;        /* source size */
+	UINT32              dwidth, dheight;        /* target size */
+};
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static UINT32 random_state = 0x12345678;
+
+
+
+/***************************************************************************
+    KERNEL WRAPPERS
+***************************************************************************/
+
+/*-------------------------------------------------
+    wrappers giving each kernel an address
+-------------------------------------------------*/
+
+static bool always_available(void)
+{
+	return true;
+}
+
+static void kernel_c(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy)
+{
+	resample_argb_bitmap_bilinear_c(dest, drowpixels, dwidth, dheight, source, srowpixels, swidth, sheight, r, g, b, a, dx, dy);
+}
+
+#ifdef RENDSAMP_SSE2
+static void kernel_sse2(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy)
+{
+	resample_argb_bitmap_bilinear_sse2(dest, drowpixels, dwidth, dheight, source, srowpixels, swidth, sheight, r, g, b, a, dx, dy);
+}
+#endif
+
+#ifdef RENDSAMP_AVX2
+static void kernel_avx2(UINT32 *dest, UINT32 drowpixels, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 srowpixels, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b, UINT32 a, UINT32 dx, UINT32 dy)
+{
+	resample_argb_bitmap_bilinear_avx2(dest, drowpixels, dwidth, dheight, source, srowpixels, swidth, sheight, r, g, b, a, dx, dy);
+}
+
+static bool avx2_available(void)
+{
+	return resample_have_avx2();
+}
+#endif
+
+static const resample_kernel kernels[] =
+{
+	{ "scalar",     kernel_c,       always_available },
+#ifdef RENDSAMP_SSE2
+	{ "SSE2",       kernel_sse2,    always_available },
+#endif
+#ifdef RENDSAMP_AVX2
+	{ "AVX2",       kernel_avx2,    avx2_available },
+#endif
+};
+
+static const resample_size sizes[] =
+{
+	{ 320, 240, 1280, 960 },                    /* bezel at 4x */
+	{ 640, 480, 1920, 1440 },                   /* artwork at 3x */
+	{ 1024, 768, 1920, 1080 },                  /* artwork to a 1080p window */
+	{ 333, 251, 1001, 777 },                    /* odd sizes */
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    random_value - return a random value below
+    'range'
+-------------------------------------------------*/
+
+static UINT32 random_value(UINT32 range)
+{
+	random_state = random_state * 1664525 + 1013904223;
+	return (random_state >> 8) % range;
+}
+
+
+/*-------------------------------------------------
+    resample - run one kernel the way
+    render_resample_argb_bitmap_hq does
+-------------------------------------------------*/
+
+static void resample(const resample_kernel &kernel, UINT32 *dest, UINT32 dwidth, UINT32 dheight, const UINT32 *source, UINT32 swidth, UINT32 sheight, UINT32 r, UINT32 g, UINT32 b)
+{
+	UINT32 dx = (swidth << 12) / dwidth;
+	UINT32 dy = (sheight << 12) / dheight;
+	(*kernel.func)(dest, dwidth, dwidth, dheight, source, swidth, swidth, sheight, r, g, b, 256, dx, dy);
+}
+
+
+/*-------------------------------------------------
+    check_random - resample random sources of
+    random sizes through every kernel with
+    random opaque colors, and return the number
+    of outputs that differ from the scalar one
+-------------------------------------------------*/
+
+static int check_random(UINT32 *source, UINT32 *expected, UINT32 *actual)
+{
+	int mismatches = 0;
+	for (int checknum = 0; checknum < NUM_RANDOM_CHECKS; checknum++)
+	{
+		UINT32 swidth = random_value(64) + 1;
+		UINT32 sheight = random_value(64) + 1;
+		UINT32 dwidth = swidth + random_value(256);
+		UINT32 dheight = sheight + random_value(256);
+		UINT32 r = random_value(257), g = random_value(257), b = random_value(257);
+		for (UINT32 index = 0; index < swidth * sheight; index++)
+			source[index] = (random_value(0x10000) << 16) | random_value(0x10000);
+
+		resample(kernels[0], expected, dwidth, dheight, source, swidth, sheight, r, g, b);
+		for (int kernnum = 1; kernnum < ARRAY_LENGTH(kernels); kernnum++)
+			if ((*kernels[kernnum].available)())
+			{
+				resample(kernels[kernnum], actual, dwidth, dheight, source, swidth, sheight, r, g, b);
+				if (memcmp(expected, actual, dwidth * dheight * sizeof(*actual)) != 0 && mismatches++ < 5)
+					fprintf(stderr, "%s: mismatch resampling %dx%d to %dx%d\n", kernels[kernnum].name, swidth, sheight, dwidth, dheight);
+			}
+	}
+	return mismatches;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int passes = DEFAULT_PASSES;
+	int argnum;
+
+	/* parse options */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-passes") == 0 && argnum + 1 < argc)
+			passes = atoi(argv[++argnum]);
+		else
+			break;
+	}
+	if (argnum < argc || passes < 1)
+	{
+		fprintf(stderr, "Usage:\n  rendbench [-passes <n>]\n");
+		return 1;
+	}
+
+	/* allocate for the largest source and target */
+	UINT32 maxsource = 64 * 64, maxdest = (64 + 256) * (64 + 256);
+	for (int sizenum = 0; sizenum < ARRAY_LENGTH(sizes); sizenum++)
+	{
+		maxsource = MAX(maxsource, sizes[sizenum].swidth * sizes[sizenum].sheight);
+		maxdest = MAX(maxdest, sizes[sizenum].dwidth * sizes[sizenum].dheight);
+	}
+	UINT32 *source = new UINT32[maxsource];
+	UINT32 *expected = new UINT32[maxdest];
+	UINT32 *actual = new UINT32[maxdest];
+
+	/* report */
+	printf("Best of %d passes, in ms per resample\n", passes);
+	printf("%-24s", "size");
+	for (int kernnum = 0; kernnum < ARRAY_LENGTH(kernels); kernnum++)
+		printf("%16s", kernels[kernnum].name);
+	printf("\n");
+
+	int mismatches = 0;
+	for (int sizenum = 0; sizenum < ARRAY_LENGTH(sizes); sizenum++)
+	{
+		const resample_size &size = sizes[sizenum];
+		for (UINT32 index = 0; index < size.swidth * size.sheight; index++)
+			source[index] = (random_value(0x10000) << 16) | random_value(0x10000);
+
+		char label[40];
+		sprintf(label, "%dx%d -> %dx%d", size.swidth, size.sheight, size.dwidth, size.dheight);
+		printf("%-24s", label);
+
+		double basems = 0;
+		for (int kernnum = 0; kernnum < ARRAY_LENGTH(kernels); kernnum++)
+		{
+			const resample_kernel &kernel = kernels[kernnum];
+			if (!(*kernel.available)())
+			{
+				printf("%16s", "n/a");
+				continue;
+			}
+
+			/* time the kernel, leaving the scalar output in 'expected' */
+			UINT32 *dest = (kernnum == 0) ? expected : actual;
+			osd_ticks_t best = ~(osd_ticks_t)0;
+			for (int pass = 0; pass < passes; pass++)
+			{
+				osd_ticks_t start = osd_ticks();
+				resample(kernel, dest, size.dwidth, size.dheight, source, size.swidth, size.sheight, 256, 256, 256);
+				osd_ticks_t elapsed = osd_ticks() - start;
+				best = MIN(best, elapsed);
+			}
+			double ms = (double)best * 1000.0 / (double)osd_ticks_per_second();
+			if (kernnum == 0)
+				basems = ms;
+
+			/* compare with the scalar output */
+			bool differ = (kernnum != 0 && memcmp(expected, actual, size.dwidth * size.dheight * sizeof(*actual)) != 0);
+			if (differ)
+				mismatches++;
+			char result[40];
+			sprintf(result, "%.2f (%.2fx)%s", ms, basems / ms, differ ? "!" : "");
+			printf("%16s", result);
+		}
+		printf("\n");
+	}
+
+	mismatches += check_random(source, expected, actual);
+	printf("%s\n", (mismatches == 0) ? "All outputs match" : "OUTPUTS DIFFER");
+	delete[] source;
+	delete[] expected;
+	delete[] actual;
+	return (mismatches == 0) ? 0 : 1;
+}
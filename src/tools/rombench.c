@@ -0,0 +1,413 @@
+/***************************************************************************
+
+    rombench.c
+
+    Times loading the members of ROM archives the way the ROM loader
+    does, one after another and pipelined on work queues. ZIP members
+    are unpacked ahead on a work queue; 7z members are unpacked in
+    order as they are opened, leaving reuse to the solid block cache.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "astring.h"
+#include "corestr.h"
+#include "unzip.h"
+#include "un7z.h"
+#include "sha1.h"
+
+#define DEFAULT_DEPTH           8
+#define DEFAULT_PASSES          5
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct archive_member
+{
+	astring             archive;                /* archive the member lives in */
+	astring             name;                   /* member name */
+	UINT32              length;                 /* uncompressed length */
+	UINT32              crc;                    /* CRC from the archive directory */
+	bool                is7z;                   /* true if the archive is a 7z */
+	zip_file *          zip;                    /* open ZIP, positioned on the member */
+	_7z_file *          _7z;                    /* open 7z, positioned on the member */
+	UINT8 *             data;                   /* unpacked data */
+	osd_work_item *     item;                   /* unpacking work, if queued */
+	bool                failed;                 /* true if unpacking failed */
+	UINT8               digest[SHA1_DIGEST_SIZE]; /* SHA1 of the unpacked data */
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    is_7z - return true if a filename names a 7z
+-------------------------------------------------*/
+
+static bool is_7z(const char *filename)
+{
+	int length = strlen(filename);
+	return (length >= 3 && core_stricmp(filename + length - 3, ".7z") == 0);
+}
+
+
+/*-------------------------------------------------
+    gather_7z_members - list the members of a 7z
+    in directory order
+-------------------------------------------------*/
+
+static int gather_7z_members(const char *filename, archive_member *members, int nummembers, int maxmembers)
+{
+	_7z_file *_7z;
+	if (_7z_file_open(filename, &_7z) != _7ZERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to open '%s'\n", filename);
+		return -1;
+	}
+
+	UInt16 name[1024];
+	for (int filenum = 0; filenum < _7z->db.db.NumFiles && nummembers < maxmembers; filenum++)
+	{
+		const CSzFileItem &file = _7z->db.db.Files[filenum];
+		if (file.IsDir || file.Size == 0 || SzArEx_GetFileNameUtf16(&_7z->db, filenum, NULL) > ARRAY_LENGTH(name))
+			continue;
+		archive_member &member = members[nummembers++];
+		member.archive.cpy(filename);
+		member.name.reset();
+		SzArEx_GetFileNameUtf16(&_7z->db, filenum, name);
+		for (int ch = 0; name[ch] != 0; ch++)
+			member.name.cat((char)name[ch]);
+		member.length = file.Size;
+		member.crc = file.Crc;
+		member.is7z = true;
+	}
+	_7z_file_close(_7z);
+	return nummembers;
+}
+
+
+/*-------------------------------------------------
+    gather_members - list the members of a ZIP
+    or 7z in directory order
+-------------------------------------------------*/
+
+static int gather_members(const char *filename, archive_member *members, int nummembers, int maxmembers)
+{
+	if (is_7z(filename))
+		return gather_7z_members(filename, members, nummembers, maxmembers);
+
+	zip_file *zip;
+	if (zip_file_open(filename, &zip) != ZIPERR_NONE)
+	{
+		fprintf(stderr, "Error: unable to open '%s'\n", filename);
+		return -1;
+	}
+
+	for (const zip_file_header *header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
+	{
+		if (header->uncompressed_length == 0 || header->filename[header->filename_length - 1] == '/')
+			continue;
+		if (nummembers == maxmembers)
+			break;
+		archive_member &member = members[nummembers++];
+		member.archive.cpy(filename);
+		member.name.cpy(header->filename, header->filename_length);
+		member.length = header->uncompressed_length;
+		member.crc = header->crc;
+		member.is7z = false;
+	}
+	zip_file_close(zip);
+	return nummembers;
+}
+
+
+/*-------------------------------------------------
+    open_member - open a member's archive and find
+    the member in it, as opening a ROM does
+-------------------------------------------------*/
+
+static void open_member(archive_member &member)
+{
+	member.zip = NULL;
+	member._7z = NULL;
+	member.data = NULL;
+	member.item = NULL;
+	member.failed = true;
+
+	if (member.is7z)
+	{
+		_7z_file *_7z;
+		if (_7z_file_open(member.archive, &_7z) != _7ZERR_NONE)
+			return;
+		if (_7z_search_crc_match(_7z, member.crc, member.name, member.name.len(), true, true) != -1)
+			member._7z = _7z;
+		else
+			_7z_file_close(_7z);
+		return;
+	}
+
+	zip_file *zip;
+	if (zip_file_open(member.archive, &zip) != ZIPERR_NONE)
+		return;
+	for (const zip_file_header *header = zip_file_first_file(zip); header != NULL; header = zip_file_next_file(zip))
+		if (member.name.cmp(header->filename, header->filename_length) == 0)
+		{
+			member.zip = zip;
+			return;
+		}
+	zip_file_close(zip);
+}
+
+
+/*-------------------------------------------------
+    unpack_member - unpack an opened member and
+    give its archive back to the cache
+-------------------------------------------------*/
+
+static void *unpack_member(void *param, int threadid)
+{
+	archive_member &member = *(archive_member *)param;
+	if (member._7z != NULL)
+	{
+		member.data = (UINT8 *)malloc(member.length);
+		member.failed = (member.data == NULL || _7z_file_decompress(member._7z, member.data, member.length) != _7ZERR_NONE);
+		_7z_file_close(member._7z);
+		member._7z = NULL;
+	}
+	else if (member.zip != NULL)
+	{
+		member.data = (UINT8 *)malloc(member.length);
+		member.failed = (member.data == NULL || zip_file_decompress(member.zip, member.data, member.length) != ZIPERR_NONE);
+		zip_file_close(member.zip);
+		member.zip = NULL;
+	}
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    hash_member - compute the SHA1 of an unpacked
+    member and free its data
+-------------------------------------------------*/
+
+static void *hash_member(void *param, int threadid)
+{
+	archive_member &member = *(archive_member *)param;
+	memset(member.digest, 0, sizeof(member.digest));
+	if (!member.failed)
+	{
+		struct sha1_ctx sha1;
+		sha1_init(&sha1);
+		sha1_update(&sha1, member.length, member.data);
+		sha1_final(&sha1);
+		sha1_digest(&sha1, sizeof(member.digest), member.digest);
+	}
+	free(member.data);
+	member.data = NULL;
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    load_sequential - open, unpack and hash each
+    member in turn
+-------------------------------------------------*/
+
+static void load_sequential(archive_member *members, int nummembers)
+{
+	for (int memnum = 0; memnum < nummembers; memnum++)
+	{
+		open_member(members[memnum]);
+		unpack_member(&members[memnum], 0);
+		hash_member(&members[memnum], 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    load_pipelined - open members in order up to
+    'depth' ahead of the one being consumed,
+    unpack them on one work queue and hash them
+    on another
+-------------------------------------------------*/
+
+static void load_pipelined(archive_member *members, int nummembers, int depth, osd_work_queue *unpackqueue, osd_work_queue *hashqueue)
+{
+	int nextmember = 0;
+	for (int memnum = 0; memnum < nummembers; memnum++)
+	{
+		/* keep the lookahead full */
+		for ( ; nextmember < nummembers && nextmember < memnum + depth; nextmember++)
+		{
+			open_member(members[nextmember]);
+			if (members[nextmember].is7z)
+				unpack_member(&members[nextmember], 0);
+			else
+				members[nextmember].item = osd_work_item_queue(unpackqueue, unpack_member, &members[nextmember], 0);
+		}
+
+		/* wait for this one, then hand it to the hashers */
+		archive_member &member = members[memnum];
+		if (member.item != NULL)
+		{
+			osd_work_item_wait(member.item, osd_ticks_per_second() * 100);
+			osd_work_item_release(member.item);
+			member.item = NULL;
+		}
+		unpack_member(&member, 0);
+		osd_work_item_queue(hashqueue, hash_member, &member, WORK_ITEM_FLAG_AUTO_RELEASE);
+	}
+	while (!osd_work_queue_wait(hashqueue, osd_ticks_per_second() * 100)) ;
+}
+
+
+/*-------------------------------------------------
+    apply_order - reorder the members to follow
+    a file listing member names one per line, as
+    a driver's ROM definitions would load them;
+    unlisted members are dropped
+-------------------------------------------------*/
+
+static int apply_order(const char *filename, archive_member *members, int nummembers)
+{
+	FILE *file = fopen(filename, "r");
+	if (file == NULL)
+	{
+		fprintf(stderr, "Error: unable to open '%s'\n", filename);
+		return -1;
+	}
+
+	archive_member *ordered = new archive_member[nummembers];
+	int numordered = 0;
+	char line[1024];
+	while (numordered < nummembers && fgets(line, sizeof(line), file) != NULL)
+	{
+		astring name(line);
+		name.trimspace();
+		for (int memnum = 0; memnum < nummembers && name.len() != 0; memnum++)
+			if (name.cmp(members[memnum].name) == 0)
+			{
+				ordered[numordered++] = members[memnum];
+				break;
+			}
+	}
+	fclose(file);
+
+	for (int memnum = 0; memnum < numordered; memnum++)
+		members[memnum] = ordered[memnum];
+	delete[] ordered;
+	return numordered;
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int depth = DEFAULT_DEPTH;
+	int passes = DEFAULT_PASSES;
+	const char *orderfile = NULL;
+	int argnum;
+
+	/* parse options */
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-depth") == 0 && argnum + 1 < argc)
+			depth = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-passes") == 0 && argnum + 1 < argc)
+			passes = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-order") == 0 && argnum + 1 < argc)
+			orderfile = argv[++argnum];
+		else
+			break;
+	}
+	if (argnum >= argc || depth < 1 || passes < 1)
+	{
+		fprintf(stderr, "Usage:\n  rombench [-depth <n>] [-passes <n>] [-order <names.txt>] <archive> [<archive> ...]\n");
+		return 1;
+	}
+
+	/* gather the members of every archive */
+	const int maxmembers = 65536;
+	archive_member *members = new archive_member[maxmembers];
+	int nummembers = 0;
+	UINT64 totalbytes = 0;
+	for ( ; argnum < argc; argnum++)
+		if ((nummembers = gather_members(argv[argnum], members, nummembers, maxmembers)) < 0)
+			return 1;
+	if (orderfile != NULL && (nummembers = apply_order(orderfile, members, nummembers)) < 0)
+		return 1;
+	for (int memnum = 0; memnum < nummembers; memnum++)
+		totalbytes += members[memnum].length;
+
+	osd_work_queue *unpackqueue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	osd_work_queue *hashqueue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	UINT8 (*reference)[SHA1_DIGEST_SIZE] = new UINT8[nummembers + 1][SHA1_DIGEST_SIZE];
+
+	/* time each strategy, starting from a cold archive cache every pass */
+	osd_ticks_t best_sequential = ~(osd_ticks_t)0, best_pipelined = ~(osd_ticks_t)0;
+	int mismatches = 0;
+	for (int pass = 0; pass < passes; pass++)
+	{
+		zip_file_cache_clear();
+		_7z_file_cache_clear();
+		osd_ticks_t start = osd_ticks();
+		load_sequential(members, nummembers);
+		osd_ticks_t elapsed = osd_ticks() - start;
+		if (elapsed < best_sequential)
+			best_sequential = elapsed;
+		for (int memnum = 0; memnum < nummembers; memnum++)
+			memcpy(reference[memnum], members[memnum].digest, SHA1_DIGEST_SIZE);
+
+		zip_file_cache_clear();
+		_7z_file_cache_clear();
+		start = osd_ticks();
+		load_pipelined(members, nummembers, depth, unpackqueue, hashqueue);
+		elapsed = osd_ticks() - start;
+		if (elapsed < best_pipelined)
+			best_pipelined = elapsed;
+		for (int memnum = 0; memnum < nummembers; memnum++)
+			if (memcmp(reference[memnum], members[memnum].digest, SHA1_DIGEST_SIZE) != 0)
+				mismatches++;
+	}
+
+	/* combine the digests so that runs against different builds can be compared */
+	UINT8 combined[SHA1_DIGEST_SIZE];
+	struct sha1_ctx sha1;
+	sha1_init(&sha1);
+	for (int memnum = 0; memnum < nummembers; memnum++)
+		sha1_update(&sha1, SHA1_DIGEST_SIZE, reference[memnum]);
+	sha1_final(&sha1);
+	sha1_digest(&sha1, sizeof(combined), combined);
+
+	/* report */
+	double ticks_per_ms = (double)osd_ticks_per_second() / 1000.0;
+	printf("%d members, %.1f MB, lookahead %d, best of %d passes\n",
+			nummembers, (double)totalbytes / (1024.0 * 1024.0), depth, passes);
+	printf("  sequential: %9.2f ms\n", (double)best_sequential / ticks_per_ms);
+	printf("  pipelined:  %9.2f ms (%.2fx)\n", (double)best_pipelined / ticks_per_ms, (double)best_sequential / (double)best_pipelined);
+	printf("  SHA1 mismatches between the two: %d\n", mismatches);
+	printf("  combined SHA1: ");
+	for (int byte = 0; byte < SHA1_DIGEST_SIZE; byte++)
+		printf("%02x", combined[byte]);
+	printf("\n");
+
+	osd_work_queue_free(hashqueue);
+	osd_work_queue_free(unpackqueue);
+	zip_file_cache_clear();
+	_7z_file_cache_clear();
+	delete[] reference;
+	delete[] members;
+	return (mismatches == 0) ? 0 : 1;
+}
@@ -63,6 +63,13 @@ TOOLS += \
 	split$(EXE) \
 	pngcmp$(EXE) \
 	nltool$(EXE) \
+	rombench$(EXE) \
+	workbench$(EXE) \
+	voodbench$(EXE) \
+	gfxbench$(EXE) \
+	hashbench$(EXE) \
+	rdpbench$(EXE) \
+	rendbench$(EXE) \
 
 
 #-------------------------------------------------
@@ -184,6 +191,97 @@ src2html$(EXE): $(SRC2HTMLOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
 
 
 
+#-------------------------------------------------
+# rombench
+#-------------------------------------------------
+
+ROMBENCHOBJS = \
+	$(TOOLSOBJ)/rombench.o \
+
+rombench$(EXE): $(ROMBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT) $(7Z_LIB)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# workbench
+#-------------------------------------------------
+
+WORKBENCHOBJS = \
+	$(TOOLSOBJ)/workbench.o \
+
+workbench$(EXE): $(WORKBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# voodbench
+#-------------------------------------------------
+
+VOODBENCHOBJS = \
+	$(TOOLSOBJ)/voodbench.o \
+
+voodbench$(EXE): $(VOODBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# gfxbench
+#-------------------------------------------------
+
+GFXBENCHOBJS = \
+	$(TOOLSOBJ)/gfxbench.o \
+
+gfxbench$(EXE): $(GFXBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# hashbench
+#-------------------------------------------------
+
+HASHBENCHOBJS = \
+	$(TOOLSOBJ)/hashbench.o \
+
+hashbench$(EXE): $(HASHBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# rdpbench
+#-------------------------------------------------
+
+RDPBENCHOBJS = \
+	$(TOOLSOBJ)/rdpbench.o \
+
+rdpbench$(EXE): $(RDPBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
+#-------------------------------------------------
+# rendbench
+#-------------------------------------------------
+
+RENDBENCHOBJS = \
+	$(TOOLSOBJ)/rendbench.o \
+
+rendbench$(EXE): $(RENDBENCHOBJS) $(LIBUTIL) $(LIBOCORE) $(ZLIB) $(EXPAT)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+
+
 #-------------------------------------------------
 # split
 #-------------------------------------------------
@@ -0,0 +1,245 @@
+/***************************************************************************
+
+    voodbench.c
+
+    Checks that the SSE2 forms of the Voodoo colour arithmetic helpers
+    in voodblend.h match the scalar forms bit for bit over random
+    inputs covering the ranges the pixel pipeline produces, and times
+    both forms.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "video/voodblend.h"
+
+#define DEFAULT_INPUTS          20000000
+#define BLOCK_INPUTS            (1 << 16)
+
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+struct blend_input
+{
+	INT32               term[4];                /* terms being scaled */
+	INT32               scale[4];               /* factors for the terms */
+	INT32               other[4];               /* terms added or blended in */
+	INT32               otherscale[4];          /* factors for the other terms (alpha blend only) */
+};
+
+typedef UINT32 (*blend_helper)(const blend_input &input);
+typedef osd_ticks_t (*blend_timer)(const blend_input *inputs, int count, UINT32 &checksum);
+
+struct blend_test
+{
+	const char *        name;                   /* helper name */
+	void                (*generate)(blend_input &input);
+	blend_helper        scalar;                 /* scalar form */
+	blend_timer         time_scalar;            /* scalar form, inlined into a timing loop */
+	blend_helper        simd;                   /* SSE2 form */
+	blend_timer         time_simd;              /* SSE2 form, inlined into a timing loop */
+};
+
+
+
+/***************************************************************************
+    INPUT GENERATION
+***************************************************************************/
+
+static UINT32 random_state = 0x12345678;
+
+/*-------------------------------------------------
+    random_range - return a random value from min
+    to max inclusive, favouring the endpoints
+-------------------------------------------------*/
+
+static INT32 random_range(INT32 min, INT32 max)
+{
+	random_state = random_state * 1664525 + 1013904223;
+	UINT32 value = random_state >> 8;
+	switch (value & 15)
+	{
+		case 0:     return min;
+		case 1:     return max;
+		default:    return min + (INT32)((value >> 4) % (UINT32)(max - min + 1));
+	}
+}
+
+
+static void generate_texture(blend_input &input)
+{
+	for (int chan = 0; chan < 4; chan++)
+	{
+		input.term[chan] = random_range(-256, 255);
+		input.scale[chan] = random_range(0, 255);
+		input.other[chan] = random_range(0, 255);
+	}
+}
+
+
+static void generate_fog(blend_input &input)
+{
+	for (int chan = 0; chan < 3; chan++)
+	{
+		input.term[chan] = random_range(-255, 255);
+		input.other[chan] = (random_state & 0x1000) ? random_range(0, 255) : 0;
+	}
+	input.scale[0] = random_range(-64, 320);
+}
+
+
+static void generate_alpha(blend_input &input)
+{
+	for (int chan = 0; chan < 3; chan++)
+	{
+		input.term[chan] = random_range(0, 255);
+		input.scale[chan] = random_range(0, 256);
+		input.other[chan] = random_range(0, 262);
+		input.otherscale[chan] = random_range(0, 256);
+	}
+	input.term[3] = random_range(0, 255);
+	input.scale[3] = (random_state & 0x1000) ? 0x100 : 0;
+	input.other[3] = random_range(0, 255);
+	input.otherscale[3] = (random_state & 0x2000) ? 0x100 : 0;
+}
+
+
+
+/***************************************************************************
+    HELPER WRAPPERS
+***************************************************************************/
+
+UINT32 texture_c(const blend_input &in)
+{
+	return texture_blend_add_clamp_c(in.term[0], in.term[1], in.term[2], in.term[3], in.scale[0], in.scale[1], in.scale[2], in.scale[3], in.other[0], in.other[1], in.other[2], in.other[3]);
+}
+
+UINT32 fog_c(const blend_input &in)
+{
+	return fog_blend_add_clamp_c(in.term[0], in.term[1], in.term[2], in.scale[0], in.other[0], in.other[1], in.other[2]);
+}
+
+UINT32 alpha_c(const blend_input &in)
+{
+	return alpha_blend_clamp_c(in.term[0], in.term[1], in.term[2], in.term[3], in.scale[0], in.scale[1], in.scale[2], in.scale[3],
+			in.other[0], in.other[1], in.other[2], in.other[3], in.otherscale[0], in.otherscale[1], in.otherscale[2], in.otherscale[3]);
+}
+
+#ifdef VOODBLEND_SSE2
+UINT32 texture_sse2(const blend_input &in)
+{
+	return texture_blend_add_clamp_sse2(in.term[0], in.term[1], in.term[2], in.term[3], in.scale[0], in.scale[1], in.scale[2], in.scale[3], in.other[0], in.other[1], in.other[2], in.other[3]);
+}
+
+UINT32 fog_sse2(const blend_input &in)
+{
+	return fog_blend_add_clamp_sse2(in.term[0], in.term[1], in.term[2], in.scale[0], in.other[0], in.other[1], in.other[2]);
+}
+
+UINT32 alpha_sse2(const blend_input &in)
+{
+	return alpha_blend_clamp_sse2(in.term[0], in.term[1], in.term[2], in.term[3], in.scale[0], in.scale[1], in.scale[2], in.scale[3],
+			in.other[0], in.other[1], in.other[2], in.other[3], in.otherscale[0], in.otherscale[1], in.otherscale[2], in.otherscale[3]);
+}
+#endif
+
+/*-------------------------------------------------
+    time_block - run one form of a helper over a
+    block of inputs, accumulating a checksum so
+    that the work can't be optimized away
+-------------------------------------------------*/
+
+template<blend_helper _Helper>
+static osd_ticks_t time_block(const blend_input *inputs, int count, UINT32 &checksum)
+{
+	osd_ticks_t start = osd_ticks();
+	for (int index = 0; index < count; index++)
+		checksum += (*_Helper)(inputs[index]);
+	return osd_ticks() - start;
+}
+
+static const blend_test tests[] =
+{
+#ifdef VOODBLEND_SSE2
+	{ "texture combine", generate_texture, texture_c, time_block<texture_c>, texture_sse2, time_block<texture_sse2> },
+	{ "fog",             generate_fog,     fog_c,     time_block<fog_c>,     fog_sse2,     time_block<fog_sse2> },
+	{ "alpha blend",     generate_alpha,   alpha_c,   time_block<alpha_c>,   alpha_sse2,   time_block<alpha_sse2> },
+#else
+	{ "texture combine", generate_texture, texture_c, time_block<texture_c>, NULL, NULL },
+	{ "fog",             generate_fog,     fog_c,     time_block<fog_c>,     NULL, NULL },
+	{ "alpha blend",     generate_alpha,   alpha_c,   time_block<alpha_c>,   NULL, NULL },
+#endif
+};
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	int numinputs = (argc > 1) ? atoi(argv[1]) : DEFAULT_INPUTS;
+	if (argc > 2 || numinputs < 1)
+	{
+		fprintf(stderr, "Usage:\n  voodbench [<inputs per helper>]\n");
+		return 1;
+	}
+#ifndef VOODBLEND_SSE2
+	printf("SSE2 forms not compiled in; timing the scalar forms only\n");
+#endif
+
+	blend_input *inputs = new blend_input[BLOCK_INPUTS];
+	memset(inputs, 0, sizeof(inputs[0]) * BLOCK_INPUTS);
+	int failures = 0;
+	for (int testnum = 0; testnum < ARRAY_LENGTH(tests); testnum++)
+	{
+		const blend_test &test = tests[testnum];
+		osd_ticks_t scalarticks = 0, simdticks = 0;
+		UINT32 scalarsum = 0, simdsum = 0;
+		int mismatches = 0;
+
+		for (int done = 0; done < numinputs; done += BLOCK_INPUTS)
+		{
+			int count = MIN(BLOCK_INPUTS, numinputs - done);
+			for (int index = 0; index < count; index++)
+				(*test.generate)(inputs[index]);
+
+			/* time both forms over the same block, then compare them */
+			scalarticks += (*test.time_scalar)(inputs, count, scalarsum);
+			if (test.simd == NULL)
+				continue;
+			simdticks += (*test.time_simd)(inputs, count, simdsum);
+			for (int index = 0; index < count; index++)
+			{
+				UINT32 expected = (*test.scalar)(inputs[index]);
+				UINT32 actual = (*test.simd)(inputs[index]);
+				if (expected != actual && mismatches++ < 5)
+					fprintf(stderr, "%s: mismatch %08X vs %08X (terms %d,%d,%d,%d)\n", test.name, expected, actual,
+							inputs[index].term[0], inputs[index].term[1], inputs[index].term[2], inputs[index].term[3]);
+			}
+		}
+
+		double scalarns = (double)scalarticks * 1e9 / (double)osd_ticks_per_second() / (double)numinputs;
+		if (test.simd == NULL)
+			printf("%-16s %d inputs, scalar %.2f ns\n", test.name, numinputs, scalarns);
+		else
+		{
+			double simdns = (double)simdticks * 1e9 / (double)osd_ticks_per_second() / (double)numinputs;
+			printf("%-16s %d inputs, %d mismatches, scalar %.2f ns, SSE2 %.2f ns (%.2fx), checksums %08X/%08X\n", test.name, numinputs, mismatches,
+					scalarns, simdns, scalarns / simdns, scalarsum, simdsum);
+		}
+		failures += mismatches;
+	}
+	delete[] inputs;
+	return (failures == 0) ? 0 : 1;
+}
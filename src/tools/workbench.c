@@ -0,0 +1,179 @@
+/***************************************************************************
+
+    workbench.c
+
+    Measures work queue throughput in items per second for single
+    queued items and for batches, over a range of thread counts. The
+    thread count is requested through OSDPROCESSORS, so it is capped
+    the same way as in the emulator; the count actually used is taken
+    from the thread IDs the callbacks see.
+
+****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osdcore.h"
+#include "eminline.h"
+
+#define DEFAULT_ITEMS           200000
+#define DEFAULT_BATCH           64
+#define DEFAULT_SPIN            0
+#define DEFAULT_PASSES          3
+
+
+
+/***************************************************************************
+    GLOBAL VARIABLES
+***************************************************************************/
+
+static volatile INT32 items_done;
+static volatile INT32 threads_seen[WORK_MAX_THREADS + 1];
+static int spin_count;
+
+
+
+/***************************************************************************
+    CORE IMPLEMENTATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    count_item - work item callback; counts
+    itself and burns a configurable amount of
+    time to stand in for real work
+-------------------------------------------------*/
+
+static void *count_item(void *param, int threadid)
+{
+	volatile UINT32 value = (UINT32)(FPTR)param;
+	for (int spin = 0; spin < spin_count; spin++)
+		value = value * 1664525 + 1013904223;
+
+	if (threadid >= 0 && threadid <= WORK_MAX_THREADS)
+		threads_seen[threadid] = 1;
+	atomic_increment32(&items_done);
+	return NULL;
+}
+
+
+/*-------------------------------------------------
+    run_single - queue every item on its own
+-------------------------------------------------*/
+
+static void run_single(osd_work_queue *queue, int numitems)
+{
+	for (int itemnum = 0; itemnum < numitems; itemnum++)
+		osd_work_item_queue(queue, count_item, (void *)(FPTR)itemnum, WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+}
+
+
+/*-------------------------------------------------
+    run_batched - queue the items in batches
+-------------------------------------------------*/
+
+static void run_batched(osd_work_queue *queue, int numitems, int batch)
+{
+	for (int itemnum = 0; itemnum < numitems; itemnum += batch)
+		osd_work_item_queue_multiple(queue, count_item, MIN(batch, numitems - itemnum), NULL, 0, WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+}
+
+
+/*-------------------------------------------------
+    time_run - time the best of several passes of
+    one mode, checking every item ran once
+-------------------------------------------------*/
+
+static double time_run(osd_work_queue *queue, int numitems, int batch, int passes, int *threadsused, bool *failed)
+{
+	osd_ticks_t best = ~(osd_ticks_t)0;
+	for (int pass = 0; pass < passes; pass++)
+	{
+		items_done = 0;
+		osd_ticks_t start = osd_ticks();
+		if (batch == 0)
+			run_single(queue, numitems);
+		else
+			run_batched(queue, numitems, batch);
+		osd_ticks_t elapsed = osd_ticks() - start;
+		if (elapsed < best)
+			best = elapsed;
+		if (items_done != numitems)
+		{
+			fprintf(stderr, "Error: %d of %d items ran\n", items_done, numitems);
+			*failed = true;
+		}
+	}
+
+	*threadsused = 0;
+	for (int threadid = 0; threadid <= WORK_MAX_THREADS; threadid++)
+		if (threads_seen[threadid])
+			(*threadsused)++;
+	return (double)numitems * (double)osd_ticks_per_second() / (double)MAX(best, 1);
+}
+
+
+/*-------------------------------------------------
+    main - main entry point
+-------------------------------------------------*/
+
+int main(int argc, char *argv[])
+{
+	static const int threadcounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+	static char envstring[ARRAY_LENGTH(threadcounts)][32];
+	int numitems = DEFAULT_ITEMS;
+	int batch = DEFAULT_BATCH;
+	int passes = DEFAULT_PASSES;
+	bool highfreq = false;
+	int argnum;
+
+	/* parse options */
+	spin_count = DEFAULT_SPIN;
+	for (argnum = 1; argnum < argc && argv[argnum][0] == '-'; argnum++)
+	{
+		if (strcmp(argv[argnum], "-items") == 0 && argnum + 1 < argc)
+			numitems = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-batch") == 0 && argnum + 1 < argc)
+			batch = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-spin") == 0 && argnum + 1 < argc)
+			spin_count = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-passes") == 0 && argnum + 1 < argc)
+			passes = atoi(argv[++argnum]);
+		else if (strcmp(argv[argnum], "-highfreq") == 0)
+			highfreq = true;
+		else
+			break;
+	}
+	if (argnum < argc || numitems < 1 || batch < 1 || spin_count < 0 || passes < 1)
+	{
+		fprintf(stderr, "Usage:\n  workbench [-items <n>] [-batch <n>] [-spin <n>] [-passes <n>] [-highfreq]\n");
+		return 1;
+	}
+
+	/* report */
+	printf("%d items, batches of %d, %d spins per item, best of %d passes%s\n", numitems, batch, spin_count, passes, highfreq ? ", high frequency queue" : "");
+	printf("threads  used    single items/s   batched items/s\n");
+	bool failed = false;
+	for (int countnum = 0; countnum < ARRAY_LENGTH(threadcounts); countnum++)
+	{
+		/* the queue reads the processor count when it is allocated */
+		sprintf(envstring[countnum], "OSDPROCESSORS=%d", threadcounts[countnum]);
+		putenv(envstring[countnum]);
+		osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | (highfreq ? WORK_QUEUE_FLAG_HIGH_FREQ : 0));
+		if (queue == NULL)
+		{
+			fprintf(stderr, "Error: unable to allocate a work queue\n");
+			return 1;
+		}
+
+		memset((void *)threads_seen, 0, sizeof(threads_seen));
+		int singleused, batchedused;
+		double single = time_run(queue, numitems, 0, passes, &singleused, &failed);
+		double batched = time_run(queue, numitems, batch, passes, &batchedused, &failed);
+		osd_work_queue_free(queue);
+
+		printf("%7d  %4d  %16.0f  %16.0f\n", threadcounts[countnum], MAX(singleused, batchedused), single, batched);
+	}
+	return failed ? 1 : 0;
+}